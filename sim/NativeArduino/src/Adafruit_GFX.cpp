@@ -0,0 +1,144 @@
+#include "Adafruit_GFX.h"
+#include "glcdfont.h"
+
+Adafruit_GFX::Adafruit_GFX(int16_t w, int16_t h) :
+    WIDTH(w),
+    HEIGHT(h),
+    _width(w),
+    _height(h)
+{
+
+}
+
+void Adafruit_GFX::fillScreen(uint16_t color) {
+    startWrite();
+
+    for (int16_t y = 0; y < _height; y++) {
+        for (int16_t x = 0; x < _width; x++) {
+            writePixel(x, y, color);
+        }
+    }
+
+    endWrite();
+}
+
+void Adafruit_GFX::setRotation(uint8_t r) {
+    rotation = r & 3;
+
+    if (rotation & 1) {
+        _width = HEIGHT;
+        _height = WIDTH;
+    } else {
+        _width = WIDTH;
+        _height = HEIGHT;
+    }
+}
+
+void Adafruit_GFX::drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size) {
+    if (gfxFont == nullptr) {
+        // Classic font
+        if (x >= _width || y >= _height || (x + 6 - 1) < 0 || (y + 8 - 1) < 0) {
+            return;
+        }
+
+        if (!_cp437 && c >= 176) {
+            c++;
+        }
+
+        const bool hasGlyph = c >= glcdfontFirst && c <= glcdfontLast;
+        startWrite();
+
+        for (int8_t i = 0; i < 5; i++) {
+            uint8_t line = hasGlyph ? glcdfont[(c - glcdfontFirst) * 5 + i] : 0;
+
+            for (int8_t j = 0; j < 8; j++, line >>= 1) {
+                if (line & 1) {
+                    writePixel(x + i, y + j, color);
+                } else if (bg != color) {
+                    writePixel(x + i, y + j, bg);
+                }
+            }
+        }
+
+        if (bg != color) {
+            for (int8_t j = 0; j < 8; j++) {
+                writePixel(x + 5, y + j, bg);
+            }
+        }
+
+        endWrite();
+        return;
+    }
+
+    // Custom font. Like the real library, the background color is ignored.
+    c -= gfxFont->first;
+    const GFXglyph* glyph = gfxFont->glyph + c;
+    const uint8_t* bitmap = gfxFont->bitmap;
+
+    uint16_t bo = glyph->bitmapOffset;
+    const uint8_t w = glyph->width;
+    const uint8_t h = glyph->height;
+    const int8_t xo = glyph->xOffset;
+    const int8_t yo = glyph->yOffset;
+    uint8_t bits = 0;
+    uint8_t bit = 0;
+
+    startWrite();
+
+    for (uint8_t yy = 0; yy < h; yy++) {
+        for (uint8_t xx = 0; xx < w; xx++) {
+            if (!(bit++ & 7)) {
+                bits = bitmap[bo++];
+            }
+
+            if (bits & 0x80) {
+                writePixel(x + xo + xx, y + yo + yy, color);
+            }
+
+            bits <<= 1;
+        }
+    }
+
+    endWrite();
+}
+
+size_t Adafruit_GFX::write(uint8_t c) {
+    if (gfxFont == nullptr) {
+        if (c == '\n') {
+            cursor_x = 0;
+            cursor_y += 8;
+        } else if (c != '\r') {
+            if (wrap && (cursor_x + 6) > _width) {
+                cursor_x = 0;
+                cursor_y += 8;
+            }
+
+            drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, 1);
+            cursor_x += 6;
+        }
+
+        return 1;
+    }
+
+    if (c == '\n') {
+        cursor_x = 0;
+        cursor_y += gfxFont->yAdvance;
+    } else if (c != '\r') {
+        if (c >= gfxFont->first && c <= gfxFont->last) {
+            const GFXglyph* glyph = gfxFont->glyph + (c - gfxFont->first);
+
+            if (glyph->width > 0 && glyph->height > 0) {
+                if (wrap && (cursor_x + glyph->xOffset + glyph->width) > _width) {
+                    cursor_x = 0;
+                    cursor_y += gfxFont->yAdvance;
+                }
+
+                drawChar(cursor_x, cursor_y, c, textcolor, textbgcolor, 1);
+            }
+
+            cursor_x += glyph->xAdvance;
+        }
+    }
+
+    return 1;
+}
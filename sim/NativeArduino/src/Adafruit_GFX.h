@@ -0,0 +1,54 @@
+#pragma once
+
+#include <Arduino.h>
+#include "gfxfont.h"
+
+// Host stand-in for the Adafruit GFX library's text drawing. Text is always
+// drawn at size 1, which is all the marquee uses, and otherwise follows the
+// real library's cursor, wrapping and clipping rules so frames come out the same.
+class Adafruit_GFX : public Print {
+public:
+    Adafruit_GFX(int16_t w, int16_t h);
+    virtual ~Adafruit_GFX() {}
+
+    virtual void drawPixel(int16_t x, int16_t y, uint16_t color) = 0;
+
+    virtual void startWrite() {}
+    virtual void writePixel(int16_t x, int16_t y, uint16_t color) { drawPixel(x, y, color); }
+    virtual void endWrite() {}
+
+    virtual void fillScreen(uint16_t color);
+    virtual void setRotation(uint8_t r);
+
+    void drawChar(int16_t x, int16_t y, unsigned char c, uint16_t color, uint16_t bg, uint8_t size);
+
+    void setCursor(int16_t x, int16_t y) { cursor_x = x; cursor_y = y; }
+    void setTextColor(uint16_t c) { textcolor = textbgcolor = c; }
+    void setTextColor(uint16_t c, uint16_t bg) { textcolor = c; textbgcolor = bg; }
+    void setTextWrap(bool w) { wrap = w; }
+    void cp437(bool x = true) { _cp437 = x; }
+    void setFont(const GFXfont* f = nullptr) { gfxFont = (GFXfont*)f; }
+
+    size_t write(uint8_t c) override;
+    using Print::write;
+
+    int16_t width() const { return _width; }
+    int16_t height() const { return _height; }
+    uint8_t getRotation() const { return rotation; }
+    int16_t getCursorX() const { return cursor_x; }
+    int16_t getCursorY() const { return cursor_y; }
+
+protected:
+    const int16_t WIDTH;
+    const int16_t HEIGHT;
+    int16_t _width;
+    int16_t _height;
+    int16_t cursor_x = 0;
+    int16_t cursor_y = 0;
+    uint16_t textcolor = 0xFFFF;
+    uint16_t textbgcolor = 0xFFFF;
+    uint8_t rotation = 0;
+    bool wrap = true;
+    bool _cp437 = false;
+    GFXfont* gfxFont = nullptr;
+};
@@ -0,0 +1,162 @@
+#pragma once
+
+#include <Adafruit_GFX.h>
+#include <Wire.h>
+
+// Host stand-in for the Adafruit IS31FL3741 library: a simulated 13x9 RGB
+// matrix that keeps the same PWM buffer as the real buffered driver. There's
+// no chip behind it; the simulator reads frames back out of the buffer, or
+// out of whatever I2CBus the firmware's DisplayFlusher writes to.
+
+#define IS3741_ADDR_DEFAULT 0x30
+
+// Same values as the real library, with the red, green and blue byte offsets packed in.
+typedef enum {
+    IS3741_RGB = ((0 << 4) | (1 << 2) | (2)),
+    IS3741_RBG = ((0 << 4) | (2 << 2) | (1)),
+    IS3741_GRB = ((1 << 4) | (0 << 2) | (2)),
+    IS3741_GBR = ((2 << 4) | (0 << 2) | (1)),
+    IS3741_BRG = ((1 << 4) | (2 << 2) | (0)),
+    IS3741_BGR = ((2 << 4) | (1 << 2) | (0)),
+} IS3741_order;
+
+class Adafruit_IS31FL3741 {
+public:
+    static constexpr uint16_t ledCount = 351;
+
+    bool begin(uint8_t address = IS3741_ADDR_DEFAULT, TwoWire* wire = &Wire) { return true; }
+    bool reset() { return true; }
+
+    bool enable(bool en = true) {
+        enabled = en;
+        return true;
+    }
+
+    bool setGlobalCurrent(uint8_t current) {
+        globalCurrent = current;
+        return true;
+    }
+
+    uint8_t getGlobalCurrent() {
+        return globalCurrent;
+    }
+
+    bool setLEDscaling(uint16_t led, uint8_t scale) {
+        if (led >= ledCount) {
+            return false;
+        }
+
+        scaling[led] = scale;
+        return true;
+    }
+
+    bool setLEDscaling(uint8_t scale) {
+        memset(scaling, scale, sizeof(scaling));
+        return true;
+    }
+
+    // Simulator access to the chip state that doesn't live in the PWM buffer.
+    bool isEnabled() const { return enabled; }
+    uint8_t getLEDscaling(uint16_t led) const { return (led < ledCount) ? scaling[led] : 0; }
+
+protected:
+    bool enabled = false;
+    uint8_t globalCurrent = 0;
+    uint8_t scaling[ledCount] = {0};
+};
+
+class Adafruit_IS31FL3741_buffered : public Adafruit_IS31FL3741 {
+public:
+    // Nothing to send; the buffer is the display.
+    void show() {}
+
+    uint8_t* getBuffer() {
+        return &ledbuf[1];
+    }
+
+protected:
+    // The first byte is where the real driver puts the register address for its bulk write.
+    uint8_t ledbuf[ledCount + 1] = {0};
+};
+
+class Adafruit_IS31FL3741_QT_buffered : public Adafruit_IS31FL3741_buffered, public Adafruit_GFX {
+public:
+    static constexpr int16_t matrixWidth = 13;
+    static constexpr int16_t matrixHeight = 9;
+
+    Adafruit_IS31FL3741_QT_buffered(IS3741_order order = IS3741_BGR) :
+        Adafruit_GFX(matrixWidth, matrixHeight),
+        rOffset((order >> 4) & 3),
+        gOffset((order >> 2) & 3),
+        bOffset(order & 3)
+    {
+
+    }
+
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+        if (x < 0 || y < 0 || x >= width() || y >= height()) {
+            return;
+        }
+
+        unrotate(x, y);
+        setUnrotatedPixel(x, y, color);
+    }
+
+    // Fills the whole matrix with one color.
+    void fill(uint16_t color = 0) {
+        for (int16_t y = 0; y < HEIGHT; y++) {
+            for (int16_t x = 0; x < WIDTH; x++) {
+                setUnrotatedPixel(x, y, color);
+            }
+        }
+    }
+
+    // Offset of the first of a pixel's three PWM registers, before rotation.
+    // The real board's LEDs are wired in a scrambled order; the simulator
+    // just lays them out row by row.
+    static uint16_t pixelOffset(int16_t x, int16_t y) {
+        return (y * matrixWidth + x) * 3;
+    }
+
+    // Reads a pixel back out of a PWM buffer laid out like this one's, using
+    // the same rotated coordinates as drawPixel().
+    void getPixelRGB(const uint8_t* buffer, int16_t x, int16_t y, uint8_t& r, uint8_t& g, uint8_t& b) const {
+        unrotate(x, y);
+
+        const uint8_t* pixel = buffer + pixelOffset(x, y);
+        r = pixel[rOffset];
+        g = pixel[gOffset];
+        b = pixel[bOffset];
+    }
+
+private:
+    void unrotate(int16_t& x, int16_t& y) const {
+        switch (getRotation()) {
+            case 1:
+                std::swap(x, y);
+                x = WIDTH - 1 - x;
+                break;
+            case 2:
+                x = WIDTH - 1 - x;
+                y = HEIGHT - 1 - y;
+                break;
+            case 3:
+                std::swap(x, y);
+                y = HEIGHT - 1 - y;
+                break;
+        }
+    }
+
+    void setUnrotatedPixel(int16_t x, int16_t y, uint16_t color) {
+        // Expand 565 to 888 the same way as the real driver.
+        uint8_t* pixel = getBuffer() + pixelOffset(x, y);
+        pixel[rOffset] = ((color >> 11) * 0x21) >> 2;
+        pixel[gOffset] = (((color >> 5) & 0x3F) * 0x41) >> 4;
+        pixel[bOffset] = ((color & 0x1F) * 0x21) >> 2;
+    }
+
+private:
+    const uint8_t rOffset;
+    const uint8_t gOffset;
+    const uint8_t bOffset;
+};
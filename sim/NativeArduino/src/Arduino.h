@@ -0,0 +1,40 @@
+#pragma once
+
+// Host stand-in for the Arduino core. See README.md.
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <math.h>
+#include <algorithm>
+
+#include "Print.h"
+#include "WString.h"
+#include "HardwareSerial.h"
+#include "Esp.h"
+
+// Same as the ESP32 core, which uses the standard library's versions rather than macros.
+using std::min;
+using std::max;
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define F(s) (s)
+#define IRAM_ATTR
+
+#define pgm_read_byte(addr) (*(const uint8_t*)(addr))
+#define pgm_read_word(addr) (*(const uint16_t*)(addr))
+#define pgm_read_dword(addr) (*(const uint32_t*)(addr))
+#define pgm_read_pointer(addr) (*(addr))
+
+// Milliseconds and microseconds since the program started.
+uint32_t millis();
+uint32_t micros();
+
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
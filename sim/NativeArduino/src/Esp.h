@@ -0,0 +1,13 @@
+#pragma once
+
+#include <stdint.h>
+
+// There's no fixed heap to report on the host, so these are always zero.
+class EspClass {
+public:
+    uint32_t getFreeHeap() { return 0; }
+    uint32_t getMinFreeHeap() { return 0; }
+    uint32_t getHeapSize() { return 0; }
+};
+
+extern EspClass ESP;
@@ -0,0 +1,18 @@
+#pragma once
+
+#include "Print.h"
+
+// Serial output goes to stdout.
+class HardwareSerial : public Print {
+public:
+    void begin(unsigned long baud) {}
+    void flush();
+
+    size_t write(uint8_t c) override;
+    size_t write(const uint8_t* buffer, size_t size) override;
+    using Print::write;
+
+    operator bool() const { return true; }
+};
+
+extern HardwareSerial Serial;
@@ -0,0 +1,87 @@
+#include <Arduino.h>
+#include <Wire.h>
+#include <esp_timer.h>
+#include <stdarg.h>
+#include <chrono>
+#include <thread>
+
+HardwareSerial Serial;
+EspClass ESP;
+TwoWire Wire;
+TwoWire Wire1;
+
+namespace {
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point startTime = Clock::now();
+}
+
+uint32_t millis() {
+    return std::chrono::duration_cast<std::chrono::milliseconds>(Clock::now() - startTime).count();
+}
+
+uint32_t micros() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime).count();
+}
+
+int64_t esp_timer_get_time() {
+    return std::chrono::duration_cast<std::chrono::microseconds>(Clock::now() - startTime).count();
+}
+
+void delay(uint32_t ms) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+    std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+void yield() {
+    std::this_thread::yield();
+}
+
+size_t Print::printf(const char* format, ...) {
+    char buffer[256];
+    char* output = buffer;
+
+    va_list args;
+    va_start(args, format);
+    int length = vsnprintf(buffer, sizeof(buffer), format, args);
+    va_end(args);
+
+    if (length < 0) {
+        return 0;
+    }
+
+    // Same as the ESP32 core: fall back to the heap for long output.
+    if (size_t(length) >= sizeof(buffer)) {
+        output = (char*)malloc(length + 1);
+
+        if (output == nullptr) {
+            return 0;
+        }
+
+        va_start(args, format);
+        vsnprintf(output, length + 1, format, args);
+        va_end(args);
+    }
+
+    size_t written = write((const uint8_t*)output, length);
+
+    if (output != buffer) {
+        free(output);
+    }
+
+    return written;
+}
+
+void HardwareSerial::flush() {
+    fflush(stdout);
+}
+
+size_t HardwareSerial::write(uint8_t c) {
+    return (fputc(c, stdout) == EOF) ? 0 : 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size) {
+    return fwrite(buffer, 1, size, stdout);
+}
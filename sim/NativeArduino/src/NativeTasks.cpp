@@ -0,0 +1,100 @@
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
+struct NativeTask {
+    std::mutex mutex;
+    std::condition_variable notified;
+    uint32_t notifyCount = 0;
+};
+
+namespace {
+    // Threads that weren't started with xTaskCreate (like main) get a task the first time they need one.
+    thread_local NativeTask* currentTask = nullptr;
+
+    NativeTask* taskForCurrentThread() {
+        if (currentTask == nullptr) {
+            currentTask = new NativeTask();
+        }
+
+        return currentTask;
+    }
+
+    struct ThreadExit {};
+}
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameters, UBaseType_t priority, TaskHandle_t* createdTask) {
+    NativeTask* task = new NativeTask();
+
+    if (createdTask != nullptr) {
+        *createdTask = task;
+    }
+
+    std::thread([function, parameters, task]() {
+        currentTask = task;
+
+        try {
+            function(parameters);
+        } catch (const ThreadExit&) {
+        }
+    }).detach();
+
+    return pdPASS;
+}
+
+void vTaskDelete(TaskHandle_t task) {
+    // Only deleting the calling task is supported. The task object is left
+    // alive, since another thread may still hold its handle.
+    if (task == nullptr || task == currentTask) {
+        throw ThreadExit();
+    }
+}
+
+TickType_t xTaskGetTickCount() {
+    return millis();
+}
+
+void vTaskDelay(TickType_t ticks) {
+    delay(ticks);
+}
+
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment) {
+    *previousWakeTime += increment;
+
+    const int32_t remaining = int32_t(*previousWakeTime - xTaskGetTickCount());
+
+    if (remaining > 0) {
+        delay(remaining);
+    }
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+    {
+        std::lock_guard<std::mutex> lock(task->mutex);
+        task->notifyCount++;
+    }
+
+    task->notified.notify_one();
+    return pdPASS;
+}
+
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait) {
+    NativeTask* task = taskForCurrentThread();
+    std::unique_lock<std::mutex> lock(task->mutex);
+
+    auto hasNotification = [task]() { return task->notifyCount > 0; };
+
+    if (ticksToWait == portMAX_DELAY) {
+        task->notified.wait(lock, hasNotification);
+    } else if (!task->notified.wait_for(lock, std::chrono::milliseconds(ticksToWait), hasNotification)) {
+        return 0;
+    }
+
+    const uint32_t count = task->notifyCount;
+    task->notifyCount = clearCountOnExit ? 0 : count - 1;
+    return count;
+}
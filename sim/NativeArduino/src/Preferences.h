@@ -0,0 +1,80 @@
+#pragma once
+
+#include <stdint.h>
+#include <map>
+#include <string>
+
+// Host stand-in for the ESP32 Preferences (NVS) library. Values are kept in
+// memory for as long as the program runs, shared by every Preferences object
+// like the real flash is, and only the types the firmware uses are here.
+class Preferences {
+public:
+    bool begin(const char* name, bool readOnly = false) {
+        if (readOnly && storage().count(name) == 0) {
+            // The real library can't open a namespace that was never written.
+            return false;
+        }
+
+        values = &storage()[name];
+        this->readOnly = readOnly;
+        return true;
+    }
+
+    void end() {
+        values = nullptr;
+    }
+
+    bool isKey(const char* key) {
+        return values != nullptr && values->count(key) != 0;
+    }
+
+    uint8_t getUChar(const char* key, uint8_t defaultValue = 0) {
+        return isKey(key) ? (*values)[key] : defaultValue;
+    }
+
+    size_t putUChar(const char* key, uint8_t value) {
+        if (values == nullptr || readOnly) {
+            return 0;
+        }
+
+        (*values)[key] = value;
+        return 1;
+    }
+
+    uint16_t getUShort(const char* key, uint16_t defaultValue = 0) {
+        return isKey(key) ? (*values)[key] : defaultValue;
+    }
+
+    size_t putUShort(const char* key, uint16_t value) {
+        if (values == nullptr || readOnly) {
+            return 0;
+        }
+
+        (*values)[key] = value;
+        return 2;
+    }
+
+    uint32_t getUInt(const char* key, uint32_t defaultValue = 0) {
+        return isKey(key) ? (*values)[key] : defaultValue;
+    }
+
+    size_t putUInt(const char* key, uint32_t value) {
+        if (values == nullptr || readOnly) {
+            return 0;
+        }
+
+        (*values)[key] = value;
+        return 4;
+    }
+
+private:
+    typedef std::map<std::string, uint32_t> Namespace;
+
+    static std::map<std::string, Namespace>& storage() {
+        static std::map<std::string, Namespace> namespaces;
+        return namespaces;
+    }
+
+    Namespace* values = nullptr;
+    bool readOnly = false;
+};
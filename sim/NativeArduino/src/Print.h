@@ -0,0 +1,47 @@
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+class Print {
+public:
+    virtual ~Print() {}
+
+    virtual size_t write(uint8_t c) = 0;
+
+    virtual size_t write(const uint8_t* buffer, size_t size) {
+        size_t n = 0;
+
+        while (size-- > 0) {
+            n += write(*buffer++);
+        }
+
+        return n;
+    }
+
+    size_t write(const char* str) {
+        return (str != nullptr) ? write((const uint8_t*)str, strlen(str)) : 0;
+    }
+
+    size_t write(const char* buffer, size_t size) {
+        return write((const uint8_t*)buffer, size);
+    }
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write(uint8_t(c)); }
+    size_t print(int n) { return printf("%d", n); }
+    size_t print(unsigned int n) { return printf("%u", n); }
+    size_t print(long n) { return printf("%ld", n); }
+    size_t print(unsigned long n) { return printf("%lu", n); }
+    size_t print(double n) { return printf("%.2f", n); }
+
+    size_t println() { return write("\r\n"); }
+
+    template<typename T>
+    size_t println(T value) {
+        return print(value) + println();
+    }
+
+    size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
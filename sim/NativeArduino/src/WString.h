@@ -0,0 +1,32 @@
+#pragma once
+
+#include <string>
+
+// The parts of Arduino's String the firmware uses, backed by std::string.
+class String {
+public:
+    String(const char* str = "") : str(str != nullptr ? str : "") {}
+    String(const std::string& str) : str(str) {}
+    String(int value) : str(std::to_string(value)) {}
+    String(unsigned int value) : str(std::to_string(value)) {}
+    String(long value) : str(std::to_string(value)) {}
+    String(unsigned long value) : str(std::to_string(value)) {}
+
+    const char* c_str() const { return str.c_str(); }
+    unsigned int length() const { return str.length(); }
+    int toInt() const { return atoi(str.c_str()); }
+
+    String& operator+=(const String& other) { str += other.str; return *this; }
+    String& operator+=(const char* other) { str += other; return *this; }
+    String& operator+=(char c) { str += c; return *this; }
+
+    friend String operator+(const String& a, const String& b) { return String(a.str + b.str); }
+
+    bool operator==(const String& other) const { return str == other.str; }
+    bool operator==(const char* other) const { return str == other; }
+    bool operator!=(const String& other) const { return str != other.str; }
+    bool operator!=(const char* other) const { return str != other; }
+
+private:
+    std::string str;
+};
@@ -0,0 +1,23 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Accepts and discards every transaction. The simulator plugs its own I2CBus
+// into the display code instead, so nothing should actually be sent here.
+class TwoWire {
+public:
+    bool setPins(int sda, int scl) { return true; }
+    bool setClock(uint32_t frequency) { return true; }
+    bool begin() { return true; }
+
+    void beginTransmission(uint8_t address) {}
+    size_t write(uint8_t data) { return 1; }
+    size_t write(const uint8_t* data, size_t length) { return length; }
+    uint8_t endTransmission(bool sendStop = true) { return 0; }
+};
+
+extern TwoWire Wire;
+extern TwoWire Wire1;
+
+#define SDA1 41
+#define SCL1 40
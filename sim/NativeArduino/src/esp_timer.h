@@ -0,0 +1,6 @@
+#pragma once
+
+#include <stdint.h>
+
+// Microseconds since the program started, on the same clock as micros().
+int64_t esp_timer_get_time();
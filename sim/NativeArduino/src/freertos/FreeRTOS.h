@@ -0,0 +1,20 @@
+#pragma once
+
+#include <stdint.h>
+
+// Host stand-in for FreeRTOS, as configured by the ESP32 Arduino core. Ticks are milliseconds.
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+
+#define pdFALSE 0
+#define pdTRUE 1
+#define pdFAIL 0
+#define pdPASS 1
+
+#define portMAX_DELAY TickType_t(0xFFFFFFFF)
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) TickType_t(ms)
+
+#define configMAX_PRIORITIES 25
@@ -0,0 +1,22 @@
+#pragma once
+
+#include "FreeRTOS.h"
+
+// Each task is a host thread. Priorities are accepted but not enforced,
+// since the host scheduler has its own ideas.
+
+struct NativeTask;
+typedef NativeTask* TaskHandle_t;
+typedef void (*TaskFunction_t)(void*);
+
+BaseType_t xTaskCreate(TaskFunction_t function, const char* name, uint32_t stackDepth, void* parameters, UBaseType_t priority, TaskHandle_t* createdTask);
+
+// Ends the calling thread when passed NULL, like on the device.
+void vTaskDelete(TaskHandle_t task);
+
+TickType_t xTaskGetTickCount();
+void vTaskDelay(TickType_t ticks);
+void vTaskDelayUntil(TickType_t* previousWakeTime, TickType_t increment);
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task);
+uint32_t ulTaskNotifyTake(BaseType_t clearCountOnExit, TickType_t ticksToWait);
@@ -0,0 +1,66 @@
+#include "AsyncFlusher.h"
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+void AsyncFlusher::begin(UBaseType_t priority) {
+    if (task != nullptr) {
+        return;
+    }
+
+    if (xTaskCreate(taskEntry, "flush", taskStackSize, this, priority, &task) != pdPASS) {
+        LOGLN("Could not start display flush task");
+        task = nullptr;
+    }
+}
+
+bool AsyncFlusher::submit(const uint8_t* frame, uint8_t globalCurrent, const uint8_t* scaling) {
+    if (busy.load(std::memory_order_acquire)) {
+        return false;
+    }
+
+    memcpy(front, frame, DisplayFlusher::frameSize);
+    frontCurrent = globalCurrent;
+
+    if (scaling != nullptr) {
+        memcpy(frontScaling, scaling, DisplayFlusher::frameSize);
+        scalingPending = true;
+    }
+
+    if (task == nullptr) {
+        flushFront();
+        return true;
+    }
+
+    busy.store(true, std::memory_order_release);
+    xTaskNotifyGive(task);
+    return true;
+}
+
+void AsyncFlusher::flushFront() {
+    const uint32_t start = micros();
+    if (flusher.flush(front, frontCurrent, scalingPending ? frontScaling : nullptr)) {
+        scalingPending = false;
+    }
+    metrics.showTime.record(micros() - start);
+
+    const DisplayFlusher::Stats& stats = flusher.lastFrameStats();
+    metrics.displayBytesSent.increment(stats.bytesSent);
+    metrics.displayBytesSaved.increment(stats.bytesSaved);
+}
+
+void AsyncFlusher::taskEntry(void* param) {
+    static_cast<AsyncFlusher*>(param)->run();
+}
+
+void AsyncFlusher::run() {
+    while (true) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        flushFront();
+
+        // Release, so the front buffer is free to be overwritten only after the flush is done with it.
+        busy.store(false, std::memory_order_release);
+    }
+}
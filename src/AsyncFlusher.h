@@ -0,0 +1,57 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "DisplayFlusher.h"
+#include "Metrics.h"
+
+// Runs a DisplayFlusher on its own task so the render loop isn't blocked for
+// the length of the I2C transfer. Frames are composed in the driver's buffer
+// (the back buffer) and copied into this object's front buffer when they're
+// submitted. The front buffer is only written while no flush is in progress,
+// so a frame is never sent half-composed or half-overwritten.
+class AsyncFlusher {
+public:
+    AsyncFlusher(DisplayFlusher& flusher, Metrics& metrics) :
+        flusher(flusher),
+        metrics(metrics)
+    {
+
+    }
+
+    // Starts the flush task. Until this is called, submit() flushes synchronously.
+    void begin(UBaseType_t priority);
+
+    // Completion flag: true when the previous frame has been fully sent.
+    inline bool isIdle() const {
+        return !busy.load(std::memory_order_acquire);
+    }
+
+    // Copies the frame into the front buffer and starts sending it, with the
+    // global current to set along with it, and the LED scaling registers if
+    // scaling isn't nullptr. Returns false, without copying anything, if the
+    // previous frame is still being sent.
+    bool submit(const uint8_t* frame, uint8_t globalCurrent, const uint8_t* scaling = nullptr);
+
+private:
+    static void taskEntry(void* param);
+    void run();
+    void flushFront();
+
+private:
+    static constexpr uint32_t taskStackSize = 3072;
+
+    DisplayFlusher& flusher;
+    Metrics& metrics;
+    TaskHandle_t task = nullptr;
+
+    uint8_t front[DisplayFlusher::frameSize] = {0};
+    uint8_t frontCurrent = DisplayFlusher::maxGlobalCurrent;
+
+    // Kept until it's been sent successfully, so a failed flush doesn't lose it.
+    uint8_t frontScaling[DisplayFlusher::frameSize] = {0};
+    bool scalingPending = false;
+    std::atomic<bool> busy{false};
+};
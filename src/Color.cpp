@@ -49,4 +49,33 @@ namespace Color {
     uint8_t gamma8(uint8_t x) {
         return gammaTable[x];
     }
+}
+
+namespace Color {
+    void LevelTable::setBrightness(uint8_t brightness) {
+        if (brightness == tableBrightness) {
+            return;
+        }
+
+        for (uint16_t channel = 0; channel < 256; channel++) {
+            // The scaled level in 255ths of a gamma table step.
+            const uint16_t scaled = channel * brightness;
+            const uint8_t step = scaled / 255;
+            const uint8_t fraction = scaled % 255;
+
+            const uint8_t below = gammaTable[step];
+            const uint8_t above = gammaTable[min(step + 1, 255)];
+            table[channel] = (below * (255 - fraction) + above * fraction + 127) / 255;
+        }
+
+        tableBrightness = brightness;
+    }
+
+    RainbowTable::RainbowTable() {
+        for (uint16_t i = 0; i < hueCount; i++) {
+            // Pick a 16 bit hue that hsv2rgb() maps back to slot i.
+            uint16_t hue = min(((i * 65536L) + 765) / 1530, 65535L);
+            table[i] = HSV(hue, 255, 255).toRGB();
+        }
+    }
 }
\ No newline at end of file
@@ -18,6 +18,14 @@ namespace Color {
         inline RGB(uint8_t r, uint8_t g, uint8_t b) : r(r), g(g), b(b) { }
         inline RGB(uint32_t packedColor) : r(packedColor >> 16), g(packedColor >> 8), b(packedColor) { }
 
+        // Expands each channel back to 8 bits, repeating the high bits into the low ones.
+        static inline RGB from565(uint16_t c) {
+            uint8_t r = (c >> 11) & 0x1F;
+            uint8_t g = (c >> 5) & 0x3F;
+            uint8_t b = c & 0x1F;
+            return RGB((r << 3) | (r >> 2), (g << 2) | (g >> 4), (b << 3) | (b >> 2));
+        }
+
         static RGB gray(uint8_t brightness) {
             return RGB(brightness, brightness, brightness);
         }
@@ -54,6 +62,18 @@ namespace Color {
             return rgb;
         }
 
+        // The same hue and saturation with the brightest channel at 255,
+        // which is what HSV's withValue(255) does, without the round trip.
+        inline RGB atFullValue() const {
+            const uint8_t v = max(max(r, g), b);
+
+            if (v == 0) {
+                return RGB();
+            }
+
+            return RGB((r * 255 + v / 2) / v, (g * 255 + v / 2) / v, (b * 255 + v / 2) / v);
+        }
+
         inline void applyGamma() {
             r = gamma8(r);
             g = gamma8(g);
@@ -163,3 +183,44 @@ namespace Color {
         uint8_t v;
     } __attribute__((packed));
 }
+
+namespace Color {
+    // What each 8 bit channel level of a full-brightness color is written to
+    // the LEDs as at one brightness: scaled, then gamma corrected. The
+    // brightness is applied at full precision, interpolating the gamma curve
+    // rather than rounding in between, and nothing is reduced to 565.
+    class LevelTable {
+    public:
+        // Recomputes the table, if the brightness has changed.
+        void setBrightness(uint8_t brightness);
+
+        inline uint8_t level(uint8_t channel) const {
+            return table[channel];
+        }
+
+        inline RGB apply(const RGB& color) const {
+            return RGB(table[color.r], table[color.g], table[color.b]);
+        }
+
+    private:
+        uint8_t table[256] = {0};
+        int16_t tableBrightness = -1;
+    };
+
+    // Every fully saturated hue at full value, for rainbow text. hsv2rgb()
+    // only distinguishes 1530 hues, so a lookup here gives exactly what the
+    // full conversion would. Brightness and gamma are applied by a LevelTable.
+    class RainbowTable {
+    public:
+        RainbowTable();
+
+        inline const RGB& colorForHue(uint16_t hue) const {
+            return table[(hue * 1530L + 32768) >> 16];
+        }
+
+    private:
+        // 1530 hues, plus the red that the hue wraps back around to.
+        static constexpr uint16_t hueCount = 1531;
+        RGB table[hueCount];
+    };
+}
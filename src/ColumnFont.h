@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+
+// A font's printable ASCII glyphs (0x20-0x7E) stored column by column: one byte
+// per 8 pixel column, bit 0 at the font's top row. Drawing a glyph only has to
+// copy a few bytes, rather than walk a row-major GFX bitmap a bit at a time, and
+// advances are a dense table lookup. The tables are generated from the GFXfont
+// headers by tools/column_fonts.py.
+struct ColumnFont {
+    static constexpr uint8_t first = 0x20;
+    static constexpr uint8_t count = 95;
+
+    struct Glyph {
+        uint16_t offset;  // Index of the glyph's first column in columns
+        int8_t x;         // Distance from the cursor to the first column
+        uint8_t width;    // Number of columns
+    };
+
+    static inline bool contains(uint8_t c) {
+        return uint8_t(c - first) < count;
+    }
+
+    // c must be in range, see contains().
+    inline const Glyph& glyph(uint8_t c) const {
+        return glyphs[c - first];
+    }
+
+    inline uint8_t advance(uint8_t c) const {
+        return advances[c - first];
+    }
+
+    inline const uint8_t* glyphColumns(const Glyph& g) const {
+        return columns + g.offset;
+    }
+
+    const uint8_t* columns;
+    const Glyph* glyphs;
+    const uint8_t* advances;
+
+    // Row of bit 0, relative to the cursor position the GFX library would draw from.
+    int8_t top;
+};
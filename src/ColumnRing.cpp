@@ -0,0 +1,42 @@
+#include "ColumnRing.h"
+
+void ColumnRing::extend(int32_t x) {
+    // Only the last capacity columns can be kept, so there's no point blanking more than that.
+    for (int32_t column = max(end, x - capacity); column < x; column++) {
+        masks[index(column)] = 0;
+    }
+
+    if (x > end) {
+        end = x;
+        first = max(first, end - capacity);
+    }
+}
+
+void ColumnRing::drawPixel(int16_t x, int16_t y, uint16_t color) {
+    const int32_t column = origin + x;
+
+    if (!contains(column) || y < 0 || y >= maxRows) {
+        return;
+    }
+
+    masks[index(column)] |= (1 << y);
+
+    // Later glyphs overwrite earlier ones, just like drawing to the matrix would.
+    colors[index(column)] = glyphColor;
+}
+
+void ColumnRing::drawColumns(int32_t x, int16_t y, const uint8_t* columns, uint8_t width, const Color::RGB& color) {
+    for (uint8_t i = 0; i < width; i++, x++) {
+        if (!contains(x) || columns[i] == 0) {
+            continue;
+        }
+
+        // Rows outside the ring fall off either end of the mask.
+        const uint16_t bits = (y >= 0) ? uint16_t(columns[i] << y) : uint16_t(columns[i] >> -y);
+
+        if (bits != 0) {
+            masks[index(x)] |= bits;
+            colors[index(x)] = color;
+        }
+    }
+}
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_GFX.h>
+#include "Color.h"
+
+// The rasterized part of the message around the visible window, stored one
+// column at a time. Each column holds a bit mask of the lit rows (bit 0 is the
+// top row) and the full 24 bit color of the glyph that drew it, exactly as it
+// goes to the LEDs. Columns are addressed by
+// their x in the whole message, but only the last `capacity` of them are kept,
+// in a ring, so memory doesn't grow with the message. Glyphs are drawn in by
+// copying ColumnFont columns, or with the regular Adafruit_GFX text functions
+// for characters the column fonts don't cover.
+class ColumnRing : public Adafruit_GFX {
+public:
+    // Enough for the widest canvas (PanelChain::maxPanels panels across), the
+    // column left of it that smooth scrolling blends in, and a glyph hanging
+    // off the right.
+    static constexpr int16_t capacity = 64;
+    static constexpr int16_t maxRows = 16;
+
+public:
+    ColumnRing() : Adafruit_GFX(capacity, maxRows) {
+        setTextWrap(false);
+    }
+
+    // Empties the ring so the next column added is column x.
+    void reset(int32_t x) {
+        first = x;
+        end = x;
+    }
+
+    // Renumbers every column, and the origin, by subtracting by. The columns
+    // stay where they are in the ring, so this costs the same however many
+    // of them there are.
+    void rebase(int32_t by) {
+        first -= by;
+        end -= by;
+        origin -= by;
+        // Only its low bits are ever used, and it grows with every rebase.
+        indexOffset = (indexOffset + by) & indexMask;
+    }
+
+    // Adds blank columns up to, but not including, column x, dropping the
+    // oldest ones if the ring is full.
+    void extend(int32_t x);
+
+    // ORs width column bytes (bit 0 at row y) into columns x onwards. Colors
+    // are only taken by columns that end up with a lit pixel, like drawPixel.
+    // Columns that aren't in the ring are skipped.
+    void drawColumns(int32_t x, int16_t y, const uint8_t* columns, uint8_t width, const Color::RGB& color);
+
+    // Adafruit_GFX drawing: x is relative to the column set with setOrigin().
+    // Pixels take the color set with setGlyphColor(), rather than GFX's 16 bit one.
+    void drawPixel(int16_t x, int16_t y, uint16_t color) override;
+
+    void setGlyphColor(const Color::RGB& color) {
+        glyphColor = color;
+    }
+
+    void setOrigin(int32_t x) {
+        origin = x;
+    }
+
+    inline uint16_t mask(int32_t column) const {
+        return contains(column) ? masks[index(column)] : 0;
+    }
+
+    inline const Color::RGB& color(int32_t column) const {
+        return colors[index(column)];
+    }
+
+private:
+    static constexpr int32_t indexMask = capacity - 1;
+    static_assert((capacity & indexMask) == 0, "capacity must be a power of two");
+
+    inline bool contains(int32_t column) const {
+        return column >= first && column < end;
+    }
+
+    inline int32_t index(int32_t column) const {
+        return (column + indexOffset) & indexMask;
+    }
+
+private:
+    // Columns first to end - 1 are in the ring.
+    int32_t first = 0;
+    int32_t end = 0;
+    int32_t origin = 0;
+    Color::RGB glyphColor;
+
+    // What rebase() has taken off the columns' numbers, so they still find their place in the ring.
+    int32_t indexOffset = 0;
+
+    uint16_t masks[capacity];
+    Color::RGB colors[capacity];
+};
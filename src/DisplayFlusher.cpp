@@ -0,0 +1,162 @@
+#include "DisplayFlusher.h"
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+namespace {
+    // IS31FL3741 registers
+    const uint8_t commandRegister = 0xFD;
+    const uint8_t commandRegisterLock = 0xFE;
+    const uint8_t commandRegisterUnlock = 0xC5;
+
+    // Page 4 holds the configuration registers.
+    const uint8_t configPage = 4;
+    const uint8_t globalCurrentRegister = 0x01;
+
+    // PWM registers 0-179 live in page 0, the remaining 171 in page 1.
+    struct PWMPage {
+        uint8_t page;
+        uint16_t start;
+        uint16_t size;
+    };
+
+    const PWMPage pwmPages[] = {
+        {0, 0, 180},
+        {1, 180, 171},
+    };
+
+    // The LED scaling registers are laid out the same way, in pages 2 and 3.
+    const PWMPage scalingPages[] = {
+        {2, 0, 180},
+        {3, 180, 171},
+    };
+}
+
+bool DisplayFlusher::flush(const uint8_t* frame, uint8_t globalCurrent, const uint8_t* scaling) {
+    stats = Stats();
+
+    const uint16_t maxRunLength = min(bus.maxWriteSize(), size_t(maxTransferSize)) - 1;
+    bool success = true;
+
+    // Before the PWM, so the new balance arrives with the frame rather than after it.
+    if (scaling != nullptr) {
+        for (const PWMPage& page : scalingPages) {
+            for (uint16_t i = 0; i < page.size; i += maxRunLength) {
+                const uint16_t runLength = min(uint16_t(page.size - i), maxRunLength);
+
+                if (!selectPage(page.page) || !writeRegisters(i, scaling + page.start + i, runLength)) {
+                    success = false;
+                }
+            }
+        }
+    }
+
+    for (const PWMPage& page : pwmPages) {
+        const uint16_t end = page.start + page.size;
+        uint16_t i = page.start;
+
+        while (i < end) {
+            // Skip to the next changed register
+            while (i < end && !changed(i, frame)) {
+                i++;
+            }
+
+            if (i == end) {
+                break;
+            }
+
+            // Extend the run while the next change is close enough to be worth including.
+            const uint16_t runStart = i;
+            uint16_t lastChanged = i;
+
+            for (uint16_t j = i + 1; j < end && (j - runStart) < maxRunLength; j++) {
+                if (changed(j, frame)) {
+                    if (j - lastChanged - 1 > mergeGap) {
+                        break;
+                    }
+
+                    lastChanged = j;
+                }
+            }
+
+            const uint16_t runLength = lastChanged - runStart + 1;
+
+            if (!selectPage(page.page) || !writeRegisters(runStart - page.start, frame + runStart, runLength)) {
+                success = false;
+            }
+
+            i = lastChanged + 1;
+        }
+    }
+
+    if (!shadowCurrentValid || globalCurrent != shadowCurrent) {
+        if (selectPage(configPage) && writeRegisters(globalCurrentRegister, &globalCurrent, 1)) {
+            shadowCurrent = globalCurrent;
+            shadowCurrentValid = true;
+        } else {
+            success = false;
+        }
+    }
+
+    uint16_t fullCost = fullFrameCost(maxRunLength);
+    stats.bytesSaved = (stats.bytesSent < fullCost) ? (fullCost - stats.bytesSent) : 0;
+
+    LOGFMT("flush: %d bytes sent, %d saved, %d transactions\n\r", stats.bytesSent, stats.bytesSaved, stats.transactions);
+
+    if (success) {
+        memcpy(shadow, frame, frameSize);
+        shadowValid = true;
+    } else {
+        LOGLN("Display flush failed");
+        invalidate();
+    }
+
+    return success;
+}
+
+uint16_t DisplayFlusher::fullFrameCost(uint16_t maxRunLength) const {
+    uint16_t cost = 0;
+
+    for (const PWMPage& page : pwmPages) {
+        uint16_t chunks = (page.size + maxRunLength - 1) / maxRunLength;
+
+        // Unlock + page select, then each chunk's device address and register address.
+        cost += 2 * 3;
+        cost += page.size + chunks * 2;
+    }
+
+    return cost;
+}
+
+bool DisplayFlusher::selectPage(uint8_t page) {
+    if (page == selectedPage) {
+        return true;
+    }
+
+    // The command register has to be unlocked before every page change.
+    const uint8_t unlock[] = {commandRegisterLock, commandRegisterUnlock};
+    const uint8_t select[] = {commandRegister, page};
+
+    if (send(unlock, sizeof(unlock)) && send(select, sizeof(select))) {
+        selectedPage = page;
+        return true;
+    }
+
+    selectedPage = -1;
+    return false;
+}
+
+bool DisplayFlusher::writeRegisters(uint8_t reg, const uint8_t* data, uint16_t length) {
+    transfer[0] = reg;
+    memcpy(transfer + 1, data, length);
+    return send(transfer, length + 1);
+}
+
+bool DisplayFlusher::send(const uint8_t* data, size_t length) {
+    // Account for the device address byte too.
+    stats.bytesSent += length + 1;
+    stats.transactions++;
+
+    return bus.write(address, data, length);
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <Arduino.h>
+#include "I2CBus.h"
+
+// Sends the IS31FL3741's PWM buffer to the chip, but only the registers that
+// changed since the previous frame. A shadow copy of what the chip holds is
+// compared against each new frame, and the changed runs are written as
+// auto-incrementing bursts. Runs separated by only a few unchanged bytes are
+// merged, since starting a new transaction costs more than resending them.
+//
+// The global current register is sent along with the frame, only when it
+// changes, so dimming the whole display costs one register write. The LED
+// scaling registers, which set the white balance, can be sent along with a
+// frame too, but they're always sent whole; they only change on request.
+//
+// Once this is in use it owns the chip's page register, so the Adafruit
+// driver's show() (which caches the selected page) must not be mixed with it.
+class DisplayFlusher {
+public:
+    // The 351 PWM registers are split across two register pages.
+    static constexpr uint16_t frameSize = 351;
+
+    // Global current that lets the LEDs reach their full PWM brightness.
+    static constexpr uint8_t maxGlobalCurrent = 255;
+
+    // Unchanged bytes between two runs that are cheaper to resend than to skip
+    // (device address + register address + start/stop for a new transaction).
+    static constexpr uint16_t mergeGap = 3;
+
+    // The longest write, register address included. Longer runs are split.
+    static constexpr size_t maxTransferSize = 128;
+
+    struct Stats {
+        // Bytes on the wire, including device addresses and page selects.
+        uint16_t bytesSent = 0;
+        // Compared to sending the whole frame the way the Adafruit driver does.
+        uint16_t bytesSaved = 0;
+        uint8_t transactions = 0;
+    };
+
+public:
+    DisplayFlusher(I2CBus& bus, uint8_t address) :
+        bus(bus),
+        address(address)
+    {
+
+    }
+
+    // Sends the frame's changed PWM registers, then the global current if
+    // that changed. If scaling isn't nullptr, all of the LED scaling
+    // registers are set from it first; it's laid out like the frame. Returns
+    // false if any write failed. The next flush then resends everything.
+    bool flush(const uint8_t* frame, uint8_t globalCurrent, const uint8_t* scaling = nullptr);
+
+    // Forget what the chip holds, so the next flush sends the whole frame.
+    void invalidate() {
+        shadowValid = false;
+        shadowCurrentValid = false;
+        selectedPage = -1;
+    }
+
+    const Stats& lastFrameStats() const {
+        return stats;
+    }
+
+private:
+    uint16_t fullFrameCost(uint16_t maxRunLength) const;
+    bool selectPage(uint8_t page);
+    bool writeRegisters(uint8_t reg, const uint8_t* data, uint16_t length);
+    bool send(const uint8_t* data, size_t length);
+
+    inline bool changed(uint16_t i, const uint8_t* frame) const {
+        return !shadowValid || frame[i] != shadow[i];
+    }
+
+private:
+    I2CBus& bus;
+    const uint8_t address;
+
+    uint8_t shadow[frameSize] = {0};
+    bool shadowValid = false;
+    uint8_t shadowCurrent = 0;
+    bool shadowCurrentValid = false;
+    int8_t selectedPage = -1;
+
+    uint8_t transfer[maxTransferSize];
+    Stats stats;
+};
@@ -0,0 +1,24 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_IS31FL3741.h>
+#include "MatrixBlitter.h"
+#include "AsyncFlusher.h"
+
+// One IS31FL3741 matrix: the driver whose buffer its part of each frame is
+// composed in, the blitter that writes to that buffer, and the flusher that
+// sends it to the chip. PanelChain puts panels side by side.
+class DisplayPanel {
+public:
+    DisplayPanel(Adafruit_IS31FL3741_QT_buffered& matrix, AsyncFlusher& flusher) :
+        matrix(matrix),
+        flusher(flusher),
+        blitter(matrix)
+    {
+
+    }
+
+    Adafruit_IS31FL3741_QT_buffered& matrix;
+    AsyncFlusher& flusher;
+    MatrixBlitter blitter;
+};
@@ -2,19 +2,58 @@
 #include "fonts/Font5x7Fixed.h"
 #include "fonts/Font5x7FixedMono.h"
 #include "fonts/Ancient4x8.h"
+#include "fonts/ColumnFonts.h"
+
+namespace ColumnFonts {
+    uint8_t classicColumns[ColumnFont::count * 5] = {0};
+}
 
 namespace  {
     const Font fonts[]= {
-        {nullptr, 1},
-        {&Font5x7Fixed, 8},
-        {&Font5x7FixedMono, 8},
-        {&Ancient4x8, 9}
+        {nullptr, 1, &ColumnFonts::classic},
+        {&Font5x7Fixed, 8, &ColumnFonts::fixed},
+        {&Font5x7FixedMono, 8, &ColumnFonts::fixedMono},
+        {&Ancient4x8, 9, &ColumnFonts::ancient}
     };
 
     const uint8_t count = sizeof(fonts) / sizeof(fonts[0]);
+
+    // The classic font's bitmap is private to the GFX library, so its columns are
+    // recorded by drawing each glyph once, side by side, and keeping what lands.
+    class ClassicFontCapture : public Adafruit_GFX {
+    public:
+        static constexpr uint8_t glyphWidth = 5;
+
+        ClassicFontCapture() : Adafruit_GFX(ColumnFont::count * Font::AdafruitFontInfo::xAdvance, 8) {
+
+        }
+
+        void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+            const uint8_t column = x % Font::AdafruitFontInfo::xAdvance;
+
+            if (column < glyphWidth) {
+                ColumnFonts::classicColumns[(x / Font::AdafruitFontInfo::xAdvance) * glyphWidth + column] |= (1 << y);
+            }
+        }
+    };
+
+    bool captureClassicColumns() {
+        ClassicFontCapture capture;
+
+        for (uint8_t i = 0; i < ColumnFont::count; i++) {
+            // Same foreground and background, as setTextColor(c) does, so only the glyph is drawn.
+            capture.drawChar(i * Font::AdafruitFontInfo::xAdvance, 0, ColumnFont::first + i, 1, 1, 1);
+        }
+
+        return true;
+    }
 }
 
 const Font& Font::withID(ID id) {
+    // Done on first use, so nothing can draw with the classic columns before they're filled in.
+    static const bool classicCaptured = captureClassicColumns();
+    (void)classicCaptured;
+
     uint8_t index = min(uint8_t(id), count);
     return fonts[index];
 }
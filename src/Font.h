@@ -2,6 +2,7 @@
 
 #include <Arduino.h>
 #include <Adafruit_GFX.h>
+#include "ColumnFont.h"
 
 struct Font {
     enum class ID: uint8_t {
@@ -13,35 +14,29 @@ struct Font {
 
     static const Font& withID(ID id);
 
+    // Each font's yOffset puts its text in a line this many rows tall. The line
+    // is centered on the display, whichever way up it is.
+    static const uint8_t lineHeight = 9;
+
     struct AdafruitFontInfo {
         static const uint8_t xAdvance = 6;
         static const uint8_t fontHeight = 6;
     };
 
     uint32_t charWidth(uint8_t c) const {
-        if (gfxFont == nullptr) {
-            return AdafruitFontInfo::xAdvance;
-        }
-
-        if (c < gfxFont->first || c > gfxFont->last) {
+        if (!ColumnFont::contains(c)) {
             return AdafruitFontInfo::xAdvance;
         }
 
-        return gfxFont->glyph[c - gfxFont->first].xAdvance;
+        return columnFont->advance(c);
     }
     
 
     uint32_t textWidth(const char* str) const {
-        const uint32_t len = strlen(str);
-        
-        if (gfxFont == nullptr) {
-            return len * AdafruitFontInfo::xAdvance;
-        }
-        
         uint32_t w = 0;
     
-        for (uint32_t i = 0; i < len; i++) {
-            w += charWidth(str[i]);
+        for (; *str != 0; str++) {
+            w += charWidth(*str);
         }
         
         return w;
@@ -49,4 +44,7 @@ struct Font {
 
     const GFXfont* gfxFont;
     const uint8_t yOffset;
-};
\ No newline at end of file
+
+    // Same glyphs as gfxFont, for drawing printable ASCII without going through GFX.
+    const ColumnFont* columnFont;
+};
@@ -0,0 +1,43 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Wire.h>
+
+// The few I2C operations the display code needs, so it can run against
+// the real TwoWire or against a stand-in that records the transactions.
+class I2CBus {
+public:
+    virtual ~I2CBus() {}
+
+    // Sends one complete write transaction. Returns true if the device acknowledged it.
+    virtual bool write(uint8_t address, const uint8_t* data, size_t length) = 0;
+
+    // Largest number of bytes a single write() can carry.
+    virtual size_t maxWriteSize() const = 0;
+};
+
+class WireBus : public I2CBus {
+public:
+    WireBus(TwoWire& wire) :
+        wire(wire)
+    {
+
+    }
+
+    bool write(uint8_t address, const uint8_t* data, size_t length) override {
+        wire.beginTransmission(address);
+        wire.write(data, length);
+        return wire.endTransmission() == 0;
+    }
+
+    size_t maxWriteSize() const override {
+#if defined(I2C_BUFFER_LENGTH)
+        return I2C_BUFFER_LENGTH;
+#else
+        return 32;
+#endif
+    }
+
+private:
+    TwoWire& wire;
+};
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Color.h"
+#include "MessageText.h"
+#include "Playlist.h"
+
+// A change to the marquee, queued by the web server task and applied by the
+// render task between frames.
+struct MarqueeCommand {
+    enum class Type : uint8_t {
+        setMessage,
+        setColor,
+        setBrightness,
+        setHardwareBrightness,
+        setScrollDelay,
+        setSmoothScrolling,
+        setFontID,
+        setRotation,
+        setPlaylist,
+        setColorOrder,
+        setWhiteBalance,
+        setPowerBudget,
+        setCenterShortMessages,
+        setLoopGap,
+    };
+
+    Type type;
+    uint8_t value;
+    Color::RGB color;
+
+    // setPowerBudget only.
+    uint16_t milliamps;
+
+    // setMessage only: a reference to the text, released by whoever ends up holding the command.
+    MessageText* message;
+
+    // setPlaylist only: a reference to the playlist, or nullptr to stop playing one. Released the same way.
+    Playlist* playlist;
+};
@@ -0,0 +1,686 @@
+#include "MarqueeController.h"
+#include <utility>
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+// The window spans the whole canvas, plus the column left of it and a glyph hanging off the right.
+static_assert(ColumnRing::capacity >= PanelChain::maxPanels * MatrixBlitter::nativeWidth + 1 + MessageRaster::maxGlyphExtent,
+    "The column ring is too small for the widest canvas");
+
+namespace {
+    // Mixes two colors with integer weights that add up to 256.
+    inline Color::RGB blend(const Color::RGB& a, uint16_t weightA, const Color::RGB& b, uint16_t weightB) {
+        return Color::RGB(
+            (a.r * weightA + b.r * weightB) >> 8,
+            (a.g * weightA + b.g * weightB) >> 8,
+            (a.b * weightA + b.b * weightB) >> 8
+        );
+    }
+}
+
+MarqueeController::~MarqueeController() {
+    MarqueeCommand command;
+
+    while (commands.pop(command)) {
+        if (command.type == MarqueeCommand::Type::setMessage) {
+            command.message->release();
+        } else if (command.type == MarqueeCommand::Type::setPlaylist && command.playlist != nullptr) {
+            command.playlist->release();
+        }
+    }
+
+    if (playlist != nullptr) {
+        playlist->release();
+    }
+
+    if (message != nullptr) {
+        message->release();
+    }
+}
+
+void MarqueeController::setMessage(const char* str) {
+    MessageText* text = MessageText::copy(str, maxMessageLength);
+
+    if (text != nullptr) {
+        setMessage(text);
+        text->release();
+    }
+}
+
+void MarqueeController::setMessage(MessageText* text) {
+    text->retain();
+
+    if (message != nullptr) {
+        message->release();
+    }
+
+    message = text;
+
+    if (playlist != nullptr) {
+        playlist->release();
+        playlist = nullptr;
+    }
+
+    showMessage();
+}
+
+void MarqueeController::setPlaylist(Playlist* list) {
+    if (list != nullptr && list->count() == 0) {
+        list = nullptr;
+    }
+
+    if (list != nullptr) {
+        list->retain();
+    }
+
+    if (playlist != nullptr) {
+        playlist->release();
+    }
+
+    playlist = list;
+
+    if (playlist == nullptr) {
+        showMessage();
+        return;
+    }
+
+    // The first item is shown straight away, so it's laid out now, like a new message.
+    showItem(*shown, 0);
+    playlistIndex = 0;
+    repeatsLeft = playlist->item(0).repeat;
+    resetScroll();
+
+    stageItem(1 % playlist->count());
+}
+
+void MarqueeController::showMessage() {
+    staged->setText(nullptr);
+    shown->setText(message);
+    shown->setFontID(fontID);
+    shown->setColor(color);
+    resetScroll();
+}
+
+void MarqueeController::showItem(MessageRaster& raster, uint8_t index) {
+    const Playlist::Item& item = playlist->item(index);
+
+    raster.setText(item.message);
+    raster.setFontID(item.fontID);
+    raster.setColor(item.color);
+    raster.setStartHue(0);
+    // Items hand over to the next one at the end of each pass, so they never loop.
+    raster.setLoopGap(0);
+}
+
+void MarqueeController::stageItem(uint8_t index) {
+    // Only swapped in at the end of a scroll, so there's time to lay it out a slice at a time.
+    stagedIndex = index;
+    showItem(*staged, index);
+}
+
+void MarqueeController::startStagedItem() {
+    if (!staged->isLaidOut()) {
+        // prepareNextItem() didn't get enough spare time; this holds up the frame.
+        LOGLN("Next playlist item wasn't ready in time");
+        staged->layoutAll();
+    }
+
+    std::swap(shown, staged);
+    playlistIndex = stagedIndex;
+    repeatsLeft = playlist->item(playlistIndex).repeat;
+
+    stageItem((playlistIndex + 1) % playlist->count());
+}
+
+bool MarqueeController::prepareNextItem() {
+    if (playlist == nullptr) {
+        return false;
+    }
+
+    if (!staged->isLaidOut()) {
+        staged->layout(layoutSliceLength);
+        return true;
+    }
+
+    if (staged->isDirty()) {
+        // The item starts just off the right edge, so its first frames only need
+        // its leading columns, as many as fit in the ring.
+        const int32_t left = -panels.width() - 1;
+        staged->rasterize(left, left + ColumnRing::capacity - MessageRaster::maxGlyphExtent);
+        return true;
+    }
+
+    return false;
+}
+
+void MarqueeController::resetScroll() {
+    // One pass over the text; nothing is kept per glyph, so this is the only
+    // part of showing a message that grows with its length.
+    shown->layoutAll();
+
+    position = panels.width() * positionOne;
+    scrollElapsed = 0;
+    scrollRemainder = 0;
+    shown->setStartHue(0);
+    shown->restart();
+}
+
+void MarqueeController::setBrightness(uint8_t b) {
+    brightness = b;
+
+    if (hardwareBrightness) {
+        // The pixels are already at full range; only the global current changes.
+        startFade(brightnessFadeTime);
+        return;
+    }
+
+    levelTable.setBrightness(b);
+
+    for (MessageRaster& raster : rasters) {
+        raster.updateLevels();
+    }
+}
+
+void MarqueeController::setHardwareBrightness(bool enabled) {
+    hardwareBrightness = enabled;
+    levelTable.setBrightness(enabled ? 255 : brightness);
+
+    for (MessageRaster& raster : rasters) {
+        raster.updateLevels();
+    }
+
+    // The pixels change with the next frame, so the current jumps along with them.
+    outputLevel = targetOutputLevel();
+    fadeElapsed = 0;
+}
+
+void MarqueeController::fadeTo(uint8_t level, uint16_t duration) {
+    fadeLevel = level;
+    startFade(duration);
+}
+
+void MarqueeController::startFade(uint16_t duration) {
+    const uint16_t target = targetOutputLevel();
+    const uint16_t distance = (target > outputLevel) ? target - outputLevel : outputLevel - target;
+
+    fadeElapsed = 0;
+
+    if (duration == 0) {
+        outputLevel = target;
+        fadeRate = 0;
+        return;
+    }
+
+    fadeRate = max(uint32_t(distance / duration), uint32_t(1));
+}
+
+bool MarqueeController::stepFade(uint32_t dt) {
+    const uint16_t target = targetOutputLevel();
+    const uint16_t distance = (target > outputLevel) ? target - outputLevel : outputLevel - target;
+    const uint8_t current = getGlobalCurrent();
+
+    if (fadeRate == 0 || fadeRate * dt >= distance) {
+        outputLevel = target;
+    } else if (target > outputLevel) {
+        outputLevel += fadeRate * dt;
+    } else {
+        outputLevel -= fadeRate * dt;
+    }
+
+    return getGlobalCurrent() != current;
+}
+
+bool MarqueeController::postMessage(const char* str) {
+    // The command carries its own copy, so the caller's buffer can go away right after this.
+    MessageText* text = MessageText::copy(str, maxMessageLength);
+
+    if (text == nullptr) {
+        return false;
+    }
+
+    const bool posted = postMessage(text);
+    text->release();
+    return posted;
+}
+
+bool MarqueeController::postMessage(MessageText* text) {
+    MarqueeCommand command;
+    command.type = MarqueeCommand::Type::setMessage;
+    command.message = text->retain();
+
+    if (!commands.push(command)) {
+        text->release();
+        return false;
+    }
+
+    return true;
+}
+
+bool MarqueeController::postPlaylist(Playlist* list) {
+    MarqueeCommand command;
+    command.type = MarqueeCommand::Type::setPlaylist;
+    command.playlist = (list != nullptr) ? list->retain() : nullptr;
+
+    if (!commands.push(command)) {
+        if (list != nullptr) {
+            list->release();
+        }
+
+        return false;
+    }
+
+    return true;
+}
+
+bool MarqueeController::postColor(const Color::RGB& newColor) {
+    MarqueeCommand command;
+    command.type = MarqueeCommand::Type::setColor;
+    command.color = newColor;
+    return commands.push(command);
+}
+
+bool MarqueeController::postBrightness(uint8_t b) {
+    return post(MarqueeCommand::Type::setBrightness, b);
+}
+
+bool MarqueeController::postHardwareBrightness(bool enabled) {
+    return post(MarqueeCommand::Type::setHardwareBrightness, enabled);
+}
+
+bool MarqueeController::postScrollDelay(uint8_t d) {
+    return post(MarqueeCommand::Type::setScrollDelay, d);
+}
+
+bool MarqueeController::postSmoothScrolling(bool smooth) {
+    return post(MarqueeCommand::Type::setSmoothScrolling, smooth);
+}
+
+bool MarqueeController::postFontID(Font::ID id) {
+    return post(MarqueeCommand::Type::setFontID, uint8_t(id));
+}
+
+bool MarqueeController::postRotation(uint8_t r) {
+    return post(MarqueeCommand::Type::setRotation, r);
+}
+
+bool MarqueeController::postColorOrder(uint8_t order) {
+    return post(MarqueeCommand::Type::setColorOrder, order);
+}
+
+bool MarqueeController::postWhiteBalance(const Color::RGB& balance) {
+    MarqueeCommand command;
+    command.type = MarqueeCommand::Type::setWhiteBalance;
+    command.color = balance;
+    return commands.push(command);
+}
+
+bool MarqueeController::postPowerBudget(uint16_t milliamps) {
+    MarqueeCommand command;
+    command.type = MarqueeCommand::Type::setPowerBudget;
+    command.milliamps = milliamps;
+    return commands.push(command);
+}
+
+bool MarqueeController::postCenterShortMessages(bool center) {
+    return post(MarqueeCommand::Type::setCenterShortMessages, center);
+}
+
+bool MarqueeController::postLoopGap(uint8_t gap) {
+    return post(MarqueeCommand::Type::setLoopGap, gap);
+}
+
+bool MarqueeController::post(MarqueeCommand::Type type, uint8_t value) {
+    MarqueeCommand command;
+    command.type = type;
+    command.value = value;
+    return commands.push(command);
+}
+
+void MarqueeController::applyCommands() {
+    MarqueeCommand command;
+
+    while (commands.pop(command)) {
+        switch (command.type) {
+            case MarqueeCommand::Type::setMessage:
+                setMessage(command.message);
+                command.message->release();
+                break;
+
+            case MarqueeCommand::Type::setColor:
+                setColor(command.color);
+                break;
+
+            case MarqueeCommand::Type::setBrightness:
+                setBrightness(command.value);
+                break;
+
+            case MarqueeCommand::Type::setHardwareBrightness:
+                setHardwareBrightness(command.value != 0);
+                break;
+
+            case MarqueeCommand::Type::setScrollDelay:
+                setScrollDelay(command.value);
+                break;
+
+            case MarqueeCommand::Type::setSmoothScrolling:
+                setSmoothScrolling(command.value != 0);
+                break;
+
+            case MarqueeCommand::Type::setFontID:
+                setFontID(Font::ID(command.value));
+                break;
+
+            case MarqueeCommand::Type::setRotation:
+                setRotation(command.value);
+                break;
+
+            case MarqueeCommand::Type::setPlaylist:
+                setPlaylist(command.playlist);
+
+                if (command.playlist != nullptr) {
+                    command.playlist->release();
+                }
+                break;
+
+            case MarqueeCommand::Type::setColorOrder:
+                setColorOrder(command.value);
+                break;
+
+            case MarqueeCommand::Type::setWhiteBalance:
+                setWhiteBalance(command.color);
+                break;
+
+            case MarqueeCommand::Type::setPowerBudget:
+                setPowerBudget(command.milliamps);
+                break;
+
+            case MarqueeCommand::Type::setCenterShortMessages:
+                setCenterShortMessages(command.value != 0);
+                break;
+
+            case MarqueeCommand::Type::setLoopGap:
+                setLoopGap(command.value);
+                break;
+        }
+    }
+}
+
+void MarqueeController::update(uint32_t dt) {
+    // Everything queued since the last frame takes effect together, before anything is drawn.
+    applyCommands();
+
+    if (framePending) {
+        presentFrame();
+    }
+
+    // Fades are stepped on their own schedule, between scroll frames if need be.
+    bool currentChanged = false;
+    fadeElapsed += dt;
+
+    if (!isFading()) {
+        fadeElapsed = 0;
+    } else if (fadeRate == 0 || fadeElapsed >= fadeStepInterval * 1000UL) {
+        currentChanged = stepFade(fadeElapsed / 1000);
+        fadeElapsed %= 1000;
+    }
+
+    scrollElapsed += dt;
+
+    const uint32_t interval = frameInterval();
+
+    bool composed = false;
+
+    if (scrollElapsed >= interval) {
+        // Frames are due every interval. Any that came due while this one was
+        // late are skipped rather than drawn in a burst, and the message
+        // catches up to where it would have been (see maxCatchUp).
+        const uint32_t late = scrollElapsed - interval;
+        const uint32_t skipped = late - late % interval;
+        scrollElapsed = late % interval;
+
+        if (skipped > 0) {
+            metrics.skippedFrames.increment(skipped / interval);
+            advance(min(skipped, uint32_t(maxCatchUp) * 1000));
+        }
+
+        // Whether what's shown loops can change with any of the above, so it's settled each frame.
+        shown->setLoopGap((playlist == nullptr && !isHeld()) ? loopGap : 0);
+
+        const int32_t drawPosition = isHeld() ? centeredPosition() : position;
+
+        // Whole pixel part of the position, rounded down, and what's left over.
+        const int32_t x0 = drawPosition >> positionFractionBits;
+        const uint8_t fraction = drawPosition & (positionOne - 1);
+
+        // Has to be checked before the window is rasterized, which clears the raster's dirty flag.
+        const bool unchanged = !sceneChanged && !shown->isDirty() && shown == composedRaster && drawPosition == composedPosition;
+        const uint8_t current = getGlobalCurrent();
+
+        rasterizeWindow(-x0);
+        limitPower(-x0, fraction, (interval + skipped) / 1000);
+        currentChanged |= getGlobalCurrent() != current;
+
+        if (unchanged) {
+            // The panels already show this frame. Its start still counts for the jitter of the next one.
+            lastFrameStart = micros();
+            metrics.idleFrames.increment();
+        } else {
+            const uint32_t composeStart = micros();
+            recordFrameStart(composeStart, interval);
+
+            panels.clear();
+
+            // Each rotation gets its own copy of the drawing loops.
+            switch (matrixRotation) {
+                case 0: compose<0>(x0, fraction); break;
+                case 1: compose<1>(x0, fraction); break;
+                case 2: compose<2>(x0, fraction); break;
+                case 3: compose<3>(x0, fraction); break;
+            }
+
+            lastComposeTime = micros() - composeStart;
+            metrics.composeTime.record(lastComposeTime);
+            LOGFMT("compose: %d us\n\r", lastComposeTime);
+
+            sceneChanged = false;
+            composedRaster = shown;
+            composedPosition = drawPosition;
+
+            presentFrame();
+            composed = true;
+        }
+
+        advance(interval);
+    }
+
+    if (currentChanged && !composed && !framePending) {
+        // Nothing new to draw, so the last frame goes again. None of its
+        // pixels have changed, so only the global current is sent.
+        presentFrame();
+    }
+}
+
+void MarqueeController::recordFrameStart(uint32_t now, uint32_t interval) {
+    if (metrics.frames.get() > 0) {
+        const int32_t jitter = int32_t(now - lastFrameStart) - int32_t(interval);
+        metrics.frameJitter.record(abs(jitter));
+    }
+
+    lastFrameStart = now;
+    metrics.frames.increment();
+}
+
+void MarqueeController::advance(uint32_t time) {
+    // Remainders carry over, so the position always comes out where the
+    // time passed puts it, however the updates fall.
+    if (smoothScrolling) {
+        const uint64_t distance = uint64_t(scrollSpeed) * time + scrollRemainder;
+        scrollRemainder = distance % 1000000;
+        position -= distance / 1000000;
+    } else {
+        const uint32_t stepTime = scrollDelay * 1000UL;
+        const uint32_t elapsed = time + scrollRemainder;
+        scrollRemainder = elapsed % stepTime;
+        position -= (elapsed / stepTime) * positionOne;
+    }
+
+    if (shown->getLoopGap() != 0) {
+        // A looping message never ends. Once the window is past its first copy,
+        // everything is renumbered so the second copy is the first, which keeps
+        // the position in range without redrawing anything.
+        const int32_t shift = shown->dropFirstCopy();
+
+        if (shift != 0) {
+            position += shift * positionOne;
+            composedPosition += shift * positionOne;
+            loadLeft -= shift;
+        }
+
+        return;
+    }
+
+    // A pass ends a pixel after the message has scrolled off. However far
+    // past that the position has got carries into the next pass, so every
+    // pass takes the same time. A big enough catch-up can finish more than one.
+    while (position < -shown->width() * positionOne) {
+        const int32_t overshoot = position + (shown->width() + 1) * positionOne;
+
+        if (playlist != nullptr && --repeatsLeft == 0) {
+            startStagedItem();
+        } else if (!isHeld()) {
+            // The window jumps back to the start of the message.
+            shown->wrap();
+        }
+
+        position = panels.width() * positionOne + overshoot;
+    }
+}
+
+void MarqueeController::updateLineTop() {
+    for (MessageRaster& raster : rasters) {
+        raster.setLineTop((panels.height() - Font::lineHeight) / 2);
+    }
+}
+
+void MarqueeController::presentFrame() {
+    // The matrix buffers are the back buffers. If the previous frame is still being
+    // sent, this one waits in them until the flushes complete (or is replaced by the
+    // next composed frame), so nothing ever tears.
+    framePending = !panels.submit(getGlobalCurrent());
+}
+
+void MarqueeController::rasterizeWindow(int32_t left) {
+    const int32_t width = panels.width();
+
+    // Unless the ring is about to be redrawn, or the window has jumped, the
+    // load only changes by the columns scrolling in and out. The ones going
+    // out are taken off while they're still in the ring.
+    const bool incremental = loadValid && loadRaster == shown && !shown->isDirty()
+        && left >= loadLeft && left - loadLeft < width;
+
+    if (incremental) {
+        for (int32_t column = loadLeft; column < left; column++) {
+            windowLoad -= columnLoad(column);
+        }
+    } else {
+        windowLoad = 0;
+    }
+
+    // Blending also reads the column left of the window.
+    shown->rasterize(left - 1, left + width);
+
+    for (int32_t column = incremental ? loadLeft + width : left; column < left + width; column++) {
+        windowLoad += columnLoad(column);
+    }
+
+    loadLeft = left;
+    loadRaster = shown;
+    loadValid = true;
+}
+
+void MarqueeController::limitPower(int32_t left, uint8_t fraction, uint32_t interval) {
+    uint32_t load = windowLoad;
+
+    if (fraction != 0) {
+        // A blended frame is part way to the window one column further left.
+        const int32_t change = int32_t(columnLoad(left - 1)) - int32_t(columnLoad(left + panels.width() - 1));
+        load += change * fraction / positionOne;
+    }
+
+    powerLimiter.update(load, uncappedGlobalCurrent(), interval);
+
+    metrics.ledCurrent.set(powerLimiter.getEstimatedCurrent());
+    metrics.maxGlobalCurrent.set(powerLimiter.getMaxGlobalCurrent());
+
+    if (powerLimiter.isLimiting()) {
+        metrics.powerLimitedFrames.increment();
+    }
+}
+
+template <uint8_t rotation>
+void MarqueeController::compose(int32_t x0, uint8_t fraction) {
+    const int16_t panelWidth = MatrixBlitter::Layout<rotation>::width;
+
+    // Each panel draws the window as if it started at its left edge.
+    for (uint8_t i = 0; i < panels.count(); i++) {
+        MatrixBlitter& blitter = panels.panel(i).blitter;
+        const int32_t panelX0 = x0 - i * panelWidth;
+
+        if (fraction == 0) {
+            drawColumns<rotation>(blitter, panelX0);
+        } else {
+            drawColumnsBlended<rotation>(blitter, panelX0, fraction);
+        }
+    }
+}
+
+template <uint8_t rotation>
+void MarqueeController::drawColumns(MatrixBlitter& blitter, int32_t x0) {
+    const MessageRaster& raster = *shown;
+
+    for (int16_t x = 0; x < MatrixBlitter::Layout<rotation>::width; x++) {
+        int32_t column = x - x0;
+        uint16_t mask = raster.columnMask(column);
+
+        if (mask != 0) {
+            blitter.drawColumn<rotation>(x, mask, raster.columnColor(column));
+        }
+    }
+}
+
+template <uint8_t rotation>
+void MarqueeController::drawColumnsBlended(MatrixBlitter& blitter, int32_t x0, uint8_t fraction) {
+    const MessageRaster& raster = *shown;
+    const int16_t visibleHeight = MatrixBlitter::Layout<rotation>::height;
+
+    // The message sits `fraction` 256ths of a pixel right of x0, so each LED
+    // blends its column with the one to its left, weighted by the fraction.
+    const uint16_t currentWeight = positionOne - fraction;
+    const uint16_t previousWeight = fraction;
+    const Color::RGB black;
+
+    for (int16_t x = 0; x < MatrixBlitter::Layout<rotation>::width; x++) {
+        int32_t column = x - x0;
+        uint16_t current = raster.columnMask(column);
+        uint16_t previous = raster.columnMask(column - 1);
+        uint16_t lit = current | previous;
+
+        if (lit == 0) {
+            continue;
+        }
+
+        const Color::RGB& currentColor = raster.columnColor(column);
+        const Color::RGB& previousColor = raster.columnColor(column - 1);
+
+        for (int16_t y = 0; lit != 0 && y < visibleHeight; y++, lit >>= 1, current >>= 1, previous >>= 1) {
+            if (lit & 1) {
+                blitter.drawPixel<rotation>(x, y, blend(
+                    (current & 1) ? currentColor : black, currentWeight,
+                    (previous & 1) ? previousColor : black, previousWeight
+                ));
+            }
+        }
+    }
+}
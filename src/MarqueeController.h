@@ -1,124 +1,259 @@
 #pragma once
 
 #include <Arduino.h>
-#include <Adafruit_IS31FL3741.h>
 #include "Font.h"
 #include "Color.h"
+#include "MessageRaster.h"
+#include "PanelChain.h"
+#include "PowerLimiter.h"
+#include "MarqueeCommand.h"
+#include "SPSCQueue.h"
+#include "Metrics.h"
+#include "MessageText.h"
+#include "Playlist.h"
 
 class MarqueeController {
 public:
-    // including terminating null character, so max string length is 511
-    static constexpr uint16_t messageBufferSize = 512;
-    static constexpr uint16_t maxMessageLength = messageBufferSize - 1;
+    // Longer messages are truncated. Only a few columns around the visible
+    // window are ever rasterized, so this is limited by the memory for the text.
+    static constexpr uint32_t maxMessageLength = 32 * 1024;
 
-public:
-    MarqueeController(Adafruit_IS31FL3741_QT_buffered& matrix) :
-        matrix(matrix), 
-        messageWidth(matrix.width()),
-        position(matrix.width())
-    {
-        setMessage("Please set a message");
-    }
+    // Scroll positions are fixed-point, with this many fractional bits.
+    static constexpr uint8_t positionFractionBits = 8;
+    static constexpr int32_t positionOne = 1 << positionFractionBits;
 
-    void resetScroll() {
-        matrix.setTextWrap(false);        
-        messageWidth = Font::withID(fontID).textWidth(message);
-        position = matrix.width();
-        scrollElapsed = 0;
-        startHue = 0;
-    }    
+    // Smooth scrolling renders at a fixed 100 Hz, whatever the scroll speed.
+    static constexpr uint8_t smoothFrameInterval = 10;
 
-    void update(uint32_t dt) {
-        scrollElapsed += dt;
-    
-        if (scrollElapsed >= scrollDelay) {
-            scrollElapsed -= scrollDelay;
+    // Characters of the next playlist item laid out per prepareNextItem() call.
+    static constexpr uint32_t layoutSliceLength = 4096;
 
-            // uint32_t drawStart = millis();
+    // While the global current is fading, it's stepped at least this often (ms).
+    static constexpr uint8_t fadeStepInterval = 10;
 
-            matrix.fill(0);
+    // How long a brightness change takes when it's made with the global current (ms).
+    static constexpr uint16_t brightnessFadeTime = 250;
 
-            auto yOffset = Font::withID(fontID).yOffset;
+    // The most a late frame makes up for (ms). Frames that came due while the
+    // render task was held up are skipped, and the message moves on to where
+    // it would have been, so it spends the same time on the display however
+    // busy the web server is. A longer stall, like a flash write, pauses the
+    // scroll for the rest of it instead of jumping the message along.
+    static constexpr uint16_t maxCatchUp = 500;
 
-            if (matrixRotation == 1 || matrixRotation == 3) {
-                yOffset += 2;
-            }
-
-            matrix.setCursor(position, yOffset);
-
-            uint32_t len = strlen(message);
-
-            if (color.isBlack()) {
-                for (unsigned int i = 0; i < len; i++) {
-                    uint16_t hue = (startHue + (i * hueStep)) & 0xFFFF;
-                    auto hsv = Color::HSV(hue, 255, brightness);
-                    matrix.setTextColor(hsv.toRGB().gammaApplied().packed565());
-                    matrix.write(message[i]);
-                }
-            }
-            else {
-                // Convert to HSV and back to replace brightness info with our own brightness setting.
-                auto hsv = Color::HSV::fromRGB(color).withValue(brightness);
-                matrix.setTextColor(hsv.toRGB().gammaApplied().packed565());
-                matrix.print(message);                
-            }
-
-            matrix.show();
-
-            // uint32_t drawFinish = millis();
-            // LOGLN(drawFinish - drawStart);
-
-            position--;
-            if( position < -messageWidth) {
-                position = matrix.width();
-                
-                // The hue continues where it left off at the end of the string's last character's color.
-                startHue = (startHue + (len * hueStep)) & 0xFFFF;
-            }
-        }
+public:
+    MarqueeController(PanelChain& panels, Metrics& metrics) :
+        panels(panels),
+        metrics(metrics),
+        rasters{{rainbowTable, levelTable}, {rainbowTable, levelTable}},
+        shown(&rasters[0]),
+        staged(&rasters[1]),
+        position(panels.width() * positionOne)
+    {
+        updateLineTop();
+        setBrightness(brightness);
+        setMessage("Please set a message");
     }
+
+    ~MarqueeController();
+
+    void resetScroll();
+
+    // Moves the marquee on by dt, the time since the last call in
+    // microseconds, and draws and sends a frame if one is due. The message's
+    // position follows the time passed, not the number of frames drawn.
+    void update(uint32_t dt);
+
+    // The post functions are for the web server task. Rather than touching the
+    // marquee's state while a frame may be rendering, they queue the change and
+    // it's applied at the start of the next update(). All of them return false if
+    // the queue is full. The setters below are only safe on the render task, or
+    // before it starts.
+    bool postMessage(const char* str);
+    // Shares text with the marquee, which takes a reference of its own.
+    bool postMessage(MessageText* text);
+    bool postColor(const Color::RGB& newColor);
+    bool postBrightness(uint8_t b);
+    bool postHardwareBrightness(bool enabled);
+    bool postScrollDelay(uint8_t d);
+    bool postSmoothScrolling(bool smooth);
+    bool postFontID(Font::ID id);
+    bool postRotation(uint8_t r);
+    bool postColorOrder(uint8_t order);
+    bool postWhiteBalance(const Color::RGB& balance);
+    bool postPowerBudget(uint16_t milliamps);
+    bool postCenterShortMessages(bool center);
+    bool postLoopGap(uint8_t gap);
+    // Shares playlist with the marquee like postMessage(). nullptr stops the current playlist.
+    bool postPlaylist(Playlist* playlist);
     
-    // Message is truncated at maxMessageLength if it's too large for the buffer.
-    void setMessage(const char* str) {
-        strncpy(message, str, messageBufferSize);
-        message[messageBufferSize - 1] = 0;
-        resetScroll();
-    }
+    // Message is truncated at maxMessageLength. If there isn't enough memory
+    // for a copy, the current message stays.
+    void setMessage(const char* str);
+
+    // Shows text without copying it. The marquee takes a reference of its own.
+    // A message replaces any playlist that's playing.
+    void setMessage(MessageText* text);
+
+    // Plays the items in order, over and over, starting with the first. The
+    // marquee takes a reference of its own. Items keep the font and color they
+    // were made with; setFontID() and setColor() apply to the message, once the
+    // playlist stops. nullptr or an empty playlist goes back to the message.
+    void setPlaylist(Playlist* list);
+
+    // Does a slice of the work to get the next playlist item ready to show:
+    // laying it out, then rasterizing its first columns. Meant for the spare
+    // time between frames, so moving on to the item is just a swap. Returns
+    // false when there's nothing left to do.
+    bool prepareNextItem();
 
     const char* getMessage() const {
-        return message;
+        return (message != nullptr) ? message->c_str() : "";
     }
                 
     void setRotation(uint8_t r) {
         r = max((uint8_t)0, r);
         r = min((uint8_t)3, r);
         matrixRotation = r;
-        matrix.setRotation(r);
+        // The blitter handles rotation itself, but the canvas width and height follow it.
+        panels.setRotation(r);
+        updateLineTop();
+        sceneChanged = true;
     }
 
     uint8_t getRotation() const {
         return matrixRotation;
     }
 
+    // The order of the LEDs' color channels, one of the IS3741_order values.
+    // Takes effect from the next frame.
+    void setColorOrder(uint8_t order) {
+        panels.setColorOrder(order);
+        sceneChanged = true;
+    }
+
+    // Each color channel's LED current, 255 being full current, so the
+    // matrices' white comes out white. See PanelChain::setWhiteBalance().
+    void setWhiteBalance(const Color::RGB& balance) {
+        panels.setWhiteBalance(balance);
+        // The LED current estimate weighs the channels by it.
+        loadValid = false;
+        sceneChanged = true;
+    }
+
+    // Dims the display as needed to keep the estimated LED current under
+    // milliamps, 0 for no limit. See PowerLimiter.
+    void setPowerBudget(uint16_t milliamps) {
+        powerLimiter.setBudget(milliamps);
+        metrics.powerBudget.set(milliamps);
+    }
+
+    const PowerLimiter& getPowerLimiter() const {
+        return powerLimiter;
+    }
+
+    // Sets the speed as the time to scroll by one pixel.
     void setScrollDelay(uint8_t d) {
+        d = max((uint8_t)1, d);
         scrollDelay = d;
+        scrollSpeed = (1000L * positionOne) / d;
     }
 
     uint8_t getScrollDelay() const {
         return scrollDelay;
     }
 
+    // Sets the speed in fixed-point pixels per second (see positionOne).
+    void setScrollSpeed(uint32_t speed) {
+        scrollSpeed = max(speed, uint32_t(1000));
+        scrollDelay = min((uint32_t(1000) * positionOne + scrollSpeed / 2) / scrollSpeed, uint32_t(255));
+    }
+
+    uint32_t getScrollSpeed() const {
+        return scrollSpeed;
+    }
+
+    // Smooth scrolling renders at a fixed high frame rate and moves by fractions
+    // of a pixel, blending neighbouring columns. Otherwise the message moves one
+    // whole pixel per frame.
+    void setSmoothScrolling(bool smooth) {
+        smoothScrolling = smooth;
+        scrollElapsed = 0;
+        scrollRemainder = 0;
+    }
+
+    bool getSmoothScrolling() const {
+        return smoothScrolling;
+    }
+
+    // Messages that fit on the display can be held still in the middle of it
+    // rather than scrolling. Nothing about a held message changes from frame
+    // to frame, so after the first one nothing is drawn or sent until
+    // something does. A held playlist item moves on after as long as it would
+    // have taken to scroll across.
+    void setCenterShortMessages(bool center) {
+        centerShortMessages = center;
+        resetScroll();
+    }
+
+    bool getCenterShortMessages() const {
+        return centerShortMessages;
+    }
+
+    // With a gap, the message loops like a ticker: the next pass follows gap
+    // columns behind the end of the last, rather than starting in from the
+    // right edge once the message has scrolled all the way off. 0 turns
+    // looping off. Playlist items and held messages don't loop.
+    void setLoopGap(uint8_t gap) {
+        loopGap = gap;
+        resetScroll();
+    }
+
+    uint8_t getLoopGap() const {
+        return loopGap;
+    }
+
+    // Microseconds until update() will have something to send to the display.
+    uint32_t timeUntilNextFrame() const {
+        if (framePending) {
+            return 1000;
+        }
+
+        const uint32_t interval = frameInterval();
+        const uint32_t untilFrame = (scrollElapsed >= interval) ? 0 : interval - scrollElapsed;
+
+        if (isFading()) {
+            const uint32_t stepInterval = fadeStepInterval * 1000UL;
+            const uint32_t untilFadeStep = (fadeElapsed >= stepInterval) ? 0 : stepInterval - fadeElapsed;
+            return min(untilFrame, untilFadeStep);
+        }
+
+        return untilFrame;
+    }
+
+    // Time it took to compose the last frame, in microseconds.
+    uint32_t getLastComposeTime() const {
+        return lastComposeTime;
+    }
+
     void setColor(const Color::RGB& newColor) {
         if (newColor == color) {
             return;
         }
 
         if (newColor.isBlack()) {
-            startHue = 0;
             color = newColor;
         } else {
             // Brightness is applied separately later, so color is stored with max brightness.
-            color = Color::HSV::fromRGB(newColor).withValue(255).toRGB();
+            color = newColor.atFullValue();
+        }
+
+        if (playlist == nullptr) {
+            if (color.isBlack()) {
+                shown->setStartHue(0);
+            }
+
+            shown->setColor(color);
         }
     }
 
@@ -126,18 +261,45 @@ public:
         return color;
     }
 
-    void setBrightness(uint8_t b) {
-        brightness = b;
-    }
+    // With hardware brightness, changes fade in over brightnessFadeTime.
+    void setBrightness(uint8_t b);
 
     uint8_t getBrightness() const {
         return brightness;
     }
 
+    // Whether brightness is applied by the LED drivers' global current, rather
+    // than to the pixel colors. Pixels then stay at full range, which keeps
+    // all of their color resolution, and a brightness change is one register
+    // write per panel instead of recoloring and redrawing the message.
+    void setHardwareBrightness(bool enabled);
+
+    bool getHardwareBrightness() const {
+        return hardwareBrightness;
+    }
+
+    // Fades the display to level (255 is the brightness setting, 0 is off)
+    // over duration ms. With a duration of 0 the level is simply set, and
+    // goes out with the next frame. Fades always use the global
+    // current, whichever way brightness is applied, and run on the render
+    // task's own schedule rather than waiting for scroll frames.
+    void fadeTo(uint8_t level, uint16_t duration);
+
+    bool isFading() const {
+        return outputLevel != targetOutputLevel();
+    }
+
+    // What the panels' global current register is set to on the next submit.
+    uint8_t getGlobalCurrent() const {
+        return min(uncappedGlobalCurrent(), powerLimiter.getMaxGlobalCurrent());
+    }
+
     void setFontID(Font::ID id) {
         fontID = id;
-        matrix.setFont(Font::withID(id).gfxFont);
-        resetScroll();        
+        if (playlist == nullptr) {
+            shown->setFontID(id);
+            resetScroll();
+        }
     }
 
     inline const Font::ID getFontID() const {
@@ -145,8 +307,82 @@ public:
     }
 
 private:
-    // LED matrix
-    Adafruit_IS31FL3741_QT_buffered& matrix;
+    void updateLineTop();
+    void showMessage();
+    void showItem(MessageRaster& raster, uint8_t index);
+    void stageItem(uint8_t index);
+    void startStagedItem();
+    void rasterizeWindow(int32_t left);
+    void limitPower(int32_t left, uint8_t fraction, uint32_t interval);
+    template <uint8_t rotation> void compose(int32_t x0, uint8_t fraction);
+    template <uint8_t rotation> void drawColumns(MatrixBlitter& blitter, int32_t x0);
+    template <uint8_t rotation> void drawColumnsBlended(MatrixBlitter& blitter, int32_t x0, uint8_t fraction);
+    void presentFrame();
+    bool post(MarqueeCommand::Type type, uint8_t value);
+    void applyCommands();
+    void advance(uint32_t time);
+    void recordFrameStart(uint32_t now, uint32_t interval);
+    void startFade(uint16_t duration);
+    bool stepFade(uint32_t dt);
+
+    // Brightness of the whole display before gamma, with any fade applied.
+    inline uint16_t targetOutputLevel() const {
+        return Color::scale8(hardwareBrightness ? brightness : 255, fadeLevel) << 8;
+    }
+
+    // The global current for the brightness and fades, before the power limit.
+    inline uint8_t uncappedGlobalCurrent() const {
+        return Color::gamma8(outputLevel >> 8);
+    }
+
+    // What a column adds to the LED current: its lit channels' PWM, each
+    // weighed by the channel's white balance.
+    inline uint32_t columnLoad(int32_t column) const {
+        const uint16_t mask = shown->columnMask(column) & ((1 << panels.height()) - 1);
+
+        if (mask == 0) {
+            return 0;
+        }
+
+        const Color::RGB& color = shown->columnColor(column);
+        const Color::RGB& balance = panels.getWhiteBalance();
+        return __builtin_popcount(mask) * (color.r * balance.r + color.g * balance.g + color.b * balance.b);
+    }
+
+    // In microseconds.
+    inline uint32_t frameInterval() const {
+        return (smoothScrolling ? smoothFrameInterval : scrollDelay) * 1000UL;
+    }
+
+    inline bool isHeld() const {
+        return centerShortMessages && shown->width() <= panels.width();
+    }
+
+    // The position that puts the message in the middle of the canvas, on a whole pixel.
+    inline int32_t centeredPosition() const {
+        return ((panels.width() - shown->width()) / 2) * positionOne;
+    }
+
+
+private:
+    // LED matrices
+    PanelChain& panels;
+    Metrics& metrics;
+
+    // Set when a composed frame couldn't be handed off because the previous one was still being sent.
+    bool framePending = false;
+
+    // What the last composed frame was drawn from. If the raster is the same
+    // and isn't dirty, the position hasn't moved and nothing else that goes
+    // into a frame has changed, the next one would come out the same, so it
+    // isn't composed or sent at all.
+    bool sceneChanged = true;
+    const MessageRaster* composedRaster = nullptr;
+    int32_t composedPosition = 0;
+
+    // Changes from the web server waiting for the next frame.
+    static constexpr uint16_t commandQueueSize = 32;
+    SPSCQueue<MarqueeCommand, commandQueueSize> commands;
 
     // Rotation settings
     uint8_t matrixRotation = 0;
@@ -159,19 +395,55 @@ private:
 
     // Brightness value
     uint8_t brightness = 255;
-
-    // message buffer
-    char message[messageBufferSize] = {0};
-    int messageWidth;    
-
-    // marque position and speed
+    bool hardwareBrightness = false;
+
+    // The global current's brightness, in 256ths so slow fades still move
+    // every step, and how fast it's heading for targetOutputLevel().
+    uint8_t fadeLevel = 255;
+    uint16_t outputLevel = 255 << 8;
+    uint32_t fadeRate = 0;
+    uint32_t fadeElapsed = 0; // us
+
+    // The LED current estimate, kept up to date a column at a time as the
+    // window scrolls: the load of the columns from loadLeft across the
+    // canvas, in loadRaster's ring.
+    PowerLimiter powerLimiter;
+    uint32_t windowLoad = 0;
+    int32_t loadLeft = 0;
+    const MessageRaster* loadRaster = nullptr;
+    bool loadValid = false;
+
+    // Rainbow colors, and the brightness and gamma applied to every color, shared by both rasters.
+    Color::RainbowTable rainbowTable;
+    Color::LevelTable levelTable;
+
+    // The message, shared with the web server.
+    MessageText* message = nullptr;
+
+    // What's on the display, and the next playlist item being got ready
+    // behind it. Moving on to the next item swaps the two.
+    MessageRaster rasters[2];
+    MessageRaster* shown;
+    MessageRaster* staged;
+
+    // The playlist, shared with the web server, or nullptr when showing the message.
+    Playlist* playlist = nullptr;
+    uint8_t playlistIndex = 0;
+    uint8_t stagedIndex = 0;
+    uint8_t repeatsLeft = 0;
+
+    // marque position and speed. A held message's position carries on as if
+    // it were scrolling, which times its passes, but it's drawn centered.
     int32_t position;
-    uint32_t scrollElapsed = 0;
+    uint32_t scrollElapsed = 0; // us since the last frame was due
+    uint32_t scrollRemainder = 0;
+    uint32_t lastComposeTime = 0;
+    uint32_t lastFrameStart = 0;
 
-    // rainbow mode
-    static constexpr uint16_t hueStep = (65536 / 12);
-    uint16_t startHue = 0;
-    
     // Speed settings
     uint8_t scrollDelay = 50;
+    uint32_t scrollSpeed = (1000L * positionOne) / 50;
+    bool smoothScrolling = false;
+    bool centerShortMessages = false;
+    uint8_t loopGap = 0;
 };
@@ -4,7 +4,7 @@
 #include <ESPAsyncWebServer.h>
 #include <AsyncJson.h>
 #include <ArduinoJson.h>
-#include "transliterateUTF8.h"
+#include "SettingsAPI.h"
 
 // Only include in this file
 #include "html/error_html.h"
@@ -15,13 +15,6 @@
 #include "Logger.h"
 
 namespace {
-    const char* apiMessageKey = "message";
-    const char* apiSpeedKey = "speed";
-    const char* apiBrightnessKey = "brightness";
-    const char* apiDisplayRotationKey = "rotation";
-    const char* apiFontKey = "font";
-    const char* apiColorKey = "textColor";
-
     const char* ssid = MARQUEE_SSID;
     const char* passphrase = MARQUEE_PASSPHRASE;
 }
@@ -38,12 +31,8 @@ void MarqueeServer::begin() {
     WiFi.softAPConfig(localIP, localIP, subnetMask);
     WiFi.softAP(ssid, passphrase, wifiChannel, 0, maxClients);
 
-    addHandlers();
-    server.begin();
-
-    LOGFMT("styles.css size: %d\n\r", sizeof(styles_css));
-
-    // Set initial message to show connection info.
+    // Set initial message to show connection info. It's posted before the
+    // server starts, so nothing else can be posting to the marquee yet.
     String connectMessage = "Wi-Fi: ";
     connectMessage += ssid;
 
@@ -55,237 +44,663 @@ void MarqueeServer::begin() {
     connectMessage += "   URL: http://";
     connectMessage += localIP.toString();
 
-    marquee.setMessage(connectMessage.c_str());
-    isShowingConnectMessage = true;    
+    MessageText* text = MessageText::copy(connectMessage.c_str(), MarqueeController::maxMessageLength);
+
+    if (text != nullptr) {
+        setCurrentMessage(text);
+        text->release();
+    }
+
+    isShowingConnectMessage = true;
+
+    addHandlers();
+    server.begin();
+
+    LOGFMT("styles.css size: %d\n\r", sizeof(styles_css));
 }
 
 void MarqueeServer::addHandlers() {
 	// Requested page not found
-	server.onNotFound([](AsyncWebServerRequest *request) {
+	server.onNotFound([this](AsyncWebServerRequest *request) {
+        const uint32_t start = micros();
         LOGFMT("Not found: %s %s\n\r", request->host().c_str(), request->url().c_str());
         AsyncWebServerResponse *response = request->beginResponse(404, "text/html", not_found_html);
         request->send(response);
+        metrics.recordRequest(Metrics::Route::notFound, start);
 	});  
 
     // Serve style sheet
-    server.on("/styles.css", HTTP_GET, [](AsyncWebServerRequest *request){
+    server.on("/styles.css", HTTP_GET, [this](AsyncWebServerRequest *request){
+        const uint32_t start = micros();
         AsyncWebServerResponse *response = request->beginResponse(200, "text/css", styles_css);
         request->send(response);
+        metrics.recordRequest(Metrics::Route::styles, start);
     });
 
     // Serve the main page
 	server.on("/", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        const uint32_t start = micros();
         LOGLN("/ GET");
-        renderer.render();
-        AsyncWebServerResponse *response = request->beginResponse(200, "text/html", renderer.getRenderedDocument());
-		request->send(response);
+        sendIndexPage(request);
+        metrics.recordRequest(Metrics::Route::index, start);
 	});      
 
+    // Frame and request metrics, in Prometheus text format
+    server.on("/metrics", HTTP_GET, [this](AsyncWebServerRequest *request) {
+        const uint32_t start = micros();
+        LOGLN("/metrics GET");
+        AsyncResponseStream *response = request->beginResponseStream("text/plain; version=0.0.4");
+        metrics.writePrometheus(*response);
+        request->send(response);
+        metrics.recordRequest(Metrics::Route::metrics, start);
+    });
+
     // Handle HTML Form submission
     server.on("/update", HTTP_POST, [this](AsyncWebServerRequest* request) {
+        const uint32_t start = micros();
         LOGLN("/update POST");
 
-        if (request->hasParam(apiMessageKey, true)) {
-            String message = request->getParam(apiMessageKey, true)->value();
-            apiSetMessage(message.c_str());
+        // Set when a change couldn't be queued for the marquee, and so wasn't made.
+        bool applied = true;
+
+        if (request->hasParam(SettingsAPI::messageKey, true)) {
+            String message = request->getParam(SettingsAPI::messageKey, true)->value();
+            applied &= apiSetMessage(message.c_str());
         }
 
-        if (request->hasParam(apiColorKey, true)) {
-            String indexString = request->getParam(apiColorKey, true)->value();
+        if (request->hasParam(SettingsAPI::colorKey, true)) {
+            String indexString = request->getParam(SettingsAPI::colorKey, true)->value();
 
             if (indexString != "") {
                 uint8_t index = atoi(indexString.c_str());
-                apiSetColor(index);
+                applied &= apiSetColor(index);
             }
         }
 
-        if (request->hasParam(apiSpeedKey, true)) {
-            String speedString = request->getParam(apiSpeedKey, true)->value();
+        if (request->hasParam(SettingsAPI::speedKey, true)) {
+            String speedString = request->getParam(SettingsAPI::speedKey, true)->value();
 
             if (speedString != "") {
                 uint8_t index = atoi(speedString.c_str());
-                apiSetSpeed(index);
+                applied &= apiSetSpeed(index);
+            }
+        }
+
+        if (request->hasParam(SettingsAPI::scrollStyleKey, true)) {
+            String styleString = request->getParam(SettingsAPI::scrollStyleKey, true)->value();
+
+            if (styleString != "") {
+                uint8_t index = atoi(styleString.c_str());
+                applied &= apiSetScrollStyle(index);
+            }
+        }
+
+        if (request->hasParam(SettingsAPI::shortMessagesKey, true)) {
+            String modeString = request->getParam(SettingsAPI::shortMessagesKey, true)->value();
+
+            if (modeString != "") {
+                uint8_t index = atoi(modeString.c_str());
+                applied &= apiSetShortMessageMode(index);
             }
         }
 
-        if (request->hasParam(apiBrightnessKey, true)) {
-            String brightnessString = request->getParam(apiBrightnessKey, true)->value();
+        if (request->hasParam(SettingsAPI::loopGapKey, true)) {
+            String gapString = request->getParam(SettingsAPI::loopGapKey, true)->value();
+
+            if (gapString != "") {
+                uint8_t index = atoi(gapString.c_str());
+                applied &= apiSetLoopGap(index);
+            }
+        }
+
+        if (request->hasParam(SettingsAPI::brightnessKey, true)) {
+            String brightnessString = request->getParam(SettingsAPI::brightnessKey, true)->value();
 
             if (brightnessString != "") {
                 uint8_t index = atoi(brightnessString.c_str()); 
-                apiSetBrightness(index);
+                applied &= apiSetBrightness(index);
             }
         }
 
-        if (request->hasParam(apiDisplayRotationKey, true)) {
-            String rotationString = request->getParam(apiDisplayRotationKey, true)->value();
+        if (request->hasParam(SettingsAPI::brightnessModeKey, true)) {
+            String modeString = request->getParam(SettingsAPI::brightnessModeKey, true)->value();
+
+            if (modeString != "") {
+                uint8_t index = atoi(modeString.c_str());
+                applied &= apiSetBrightnessMode(index);
+            }
+        }
+
+        if (request->hasParam(SettingsAPI::displayRotationKey, true)) {
+            String rotationString = request->getParam(SettingsAPI::displayRotationKey, true)->value();
 
             if (rotationString != "") {
                 uint8_t index = atoi(rotationString.c_str());
-                apiSetDisplayRotation(index);
+                applied &= apiSetDisplayRotation(index);
             }
         }        
 
-        if (request->hasParam(apiFontKey, true)) {
-            String indexString = request->getParam(apiFontKey, true)->value();
+        if (request->hasParam(SettingsAPI::fontKey, true)) {
+            String indexString = request->getParam(SettingsAPI::fontKey, true)->value();
 
             if (indexString != "") {
                 uint8_t index = atoi(indexString.c_str());
-                apiSetFont(index);
+                applied &= apiSetFont(index);
             }
         }
 
-        renderer.render();
-        
-        request->send(200, "text/html", renderer.getRenderedDocument()); 
+        if (request->hasParam(SettingsAPI::colorOrderKey, true)) {
+            String indexString = request->getParam(SettingsAPI::colorOrderKey, true)->value();
+
+            if (indexString != "") {
+                uint8_t index = atoi(indexString.c_str());
+                applied &= apiSetColorOrder(index);
+            }
+        }
+
+        if (request->hasParam(SettingsAPI::whiteBalanceKey, true)) {
+            String balanceString = request->getParam(SettingsAPI::whiteBalanceKey, true)->value();
+            applied &= apiSetWhiteBalance(balanceString.c_str());
+        }
+
+        if (request->hasParam(SettingsAPI::powerBudgetKey, true)) {
+            String budgetString = request->getParam(SettingsAPI::powerBudgetKey, true)->value();
+
+            if (budgetString != "") {
+                applied &= apiSetPowerBudget(constrain(atoi(budgetString.c_str()), 0, 65535));
+            }
+        }
+
+        if (applied) {
+            sendIndexPage(request);
+        } else {
+            sendServiceUnavailable(request);
+        }
+
+        metrics.recordRequest(Metrics::Route::update, start);
     });
 
     // Settings JSON API - GET
     server.on("/settings", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        const uint32_t start = micros();
         LOGLN("/settings GET");
 
         sendSettingsResponse(request);
+        metrics.recordRequest(Metrics::Route::settingsGet, start);
     });    
 
     // Settings JSON API - POST
     AsyncCallbackJsonWebHandler* handler = new AsyncCallbackJsonWebHandler("/settings", [this](AsyncWebServerRequest *request, JsonVariant &jsonVariant) {
+        const uint32_t start = micros();
         LOGLN("/settings POST");
 
+        // Set when a change couldn't be queued for the marquee, and so wasn't made.
+        bool applied = true;
+
         JsonObject json = jsonVariant.as<JsonObject>();
 
         // Update the message
-        const char* message = json[apiMessageKey];
-        apiSetMessage(message);
+        const char* message = json[SettingsAPI::messageKey];
+        applied &= apiSetMessage(message);
 
         // Update the color
-        uint8_t color = json[apiColorKey];
-        apiSetColor(color);
+        uint8_t color = json[SettingsAPI::colorKey];
+        applied &= apiSetColor(color);
 
         // Update the brightness
-        uint8_t newBrightnessIndex = json[apiBrightnessKey];
-        apiSetBrightness(newBrightnessIndex);
+        uint8_t newBrightnessIndex = json[SettingsAPI::brightnessKey];
+        applied &= apiSetBrightness(newBrightnessIndex);
+
+        // Update the brightness mode
+        uint8_t newBrightnessModeIndex = json[SettingsAPI::brightnessModeKey];
+        applied &= apiSetBrightnessMode(newBrightnessModeIndex);
 
         // Update the text speed
-        uint8_t newSpeedIndex = json[apiSpeedKey];
-        apiSetSpeed(newSpeedIndex);
+        uint8_t newSpeedIndex = json[SettingsAPI::speedKey];
+        applied &= apiSetSpeed(newSpeedIndex);
+
+        // Update the scroll style
+        uint8_t newScrollStyleIndex = json[SettingsAPI::scrollStyleKey];
+        applied &= apiSetScrollStyle(newScrollStyleIndex);
+
+        // Update how short messages are shown. Older clients don't send it, so they leave it be.
+        uint8_t newShortMessageModeIndex = json[SettingsAPI::shortMessagesKey] | settings.shortMessageModes.currentIndex();
+        applied &= apiSetShortMessageMode(newShortMessageModeIndex);
+
+        // Update the loop gap, likewise left be by older clients.
+        uint8_t newLoopGapIndex = json[SettingsAPI::loopGapKey] | settings.loopGaps.currentIndex();
+        applied &= apiSetLoopGap(newLoopGapIndex);
 
         // Update the font
-        uint8_t newFontIndex = json[apiFontKey];
-        apiSetFont(newFontIndex);
+        uint8_t newFontIndex = json[SettingsAPI::fontKey];
+        applied &= apiSetFont(newFontIndex);
 
         // Update the rotation
-        uint8_t newRotation = json[apiDisplayRotationKey];
-        apiSetDisplayRotation(newRotation);
+        uint8_t newRotation = json[SettingsAPI::displayRotationKey];
+        applied &= apiSetDisplayRotation(newRotation);
+
+        // Update the color order. It's saved, so it's only changed when it's asked for.
+        uint8_t newColorOrder = json[SettingsAPI::colorOrderKey] | settings.colorOrders.currentIndex();
+        applied &= apiSetColorOrder(newColorOrder);
+
+        // Update the white balance. Also saved, and only there when it's being set.
+        const char* newWhiteBalance = json[SettingsAPI::whiteBalanceKey];
+        applied &= apiSetWhiteBalance(newWhiteBalance);
+
+        // Update the power budget, saved the same way.
+        uint16_t newPowerBudget = json[SettingsAPI::powerBudgetKey] | settings.powerBudget;
+        applied &= apiSetPowerBudget(newPowerBudget);
 
         // Send updated response
-        sendSettingsResponse(request);
+        if (applied) {
+            sendSettingsResponse(request);
+        } else {
+            sendServiceUnavailable(request);
+        }
+
+        metrics.recordRequest(Metrics::Route::settingsPost, start);
     });
+    handler->setMaxContentLength(SettingsAPI::maxRequestSize);
     server.addHandler(handler);
+
+    // Playlist JSON API - GET
+    server.on("/playlist", HTTP_GET, [this](AsyncWebServerRequest* request) {
+        const uint32_t start = micros();
+        LOGLN("/playlist GET");
+
+        sendPlaylistResponse(request);
+        metrics.recordRequest(Metrics::Route::playlistGet, start);
+    });
+
+    // Playlist JSON API - POST. Replaces the whole playlist; an empty one goes back to the message.
+    AsyncCallbackJsonWebHandler* playlistHandler = new AsyncCallbackJsonWebHandler("/playlist", [this](AsyncWebServerRequest *request, JsonVariant &jsonVariant) {
+        const uint32_t start = micros();
+        LOGLN("/playlist POST");
+
+        JsonArrayConst items = jsonVariant[SettingsAPI::playlistItemsKey];
+
+        if (apiSetPlaylist(items)) {
+            sendPlaylistResponse(request);
+        } else {
+            sendServiceUnavailable(request);
+        }
+
+        metrics.recordRequest(Metrics::Route::playlistPost, start);
+    });
+    playlistHandler->setMaxContentLength(SettingsAPI::maxRequestSize);
+    server.addHandler(playlistHandler);
 }
 
-void MarqueeServer::sendSettingsResponse(AsyncWebServerRequest *request) {
-    JsonDocument responseJSON;
+void MarqueeServer::sendIndexPage(AsyncWebServerRequest *request) {
+    // The page goes out a chunk at a time as the connection takes it, each
+    // written straight from the template and the settings as they are then.
+    WebRenderer::Cursor cursor;
 
+    AsyncWebServerResponse *response = request->beginChunkedResponse("text/html", [this, cursor](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t {
+        return renderer.read(cursor, buffer, maxLen);
+    });
+
+    request->send(response);
+}
+
+void MarqueeServer::sendServiceUnavailable(AsyncWebServerRequest *request) {
+    AsyncWebServerResponse *response = request->beginResponse(503, "text/html", service_unavailable_html);
+    response->addHeader("Retry-After", "1");
+    request->send(response);
+}
+
+void MarqueeServer::sendSettingsResponse(AsyncWebServerRequest *request) {
     // The device's initially displayed message is the connection details,
     // so be careful not to leak them through the API.
-    if (isShowingConnectMessage == false) {
-        responseJSON[apiMessageKey] = marquee.getMessage();        
-    } else {
-        responseJSON[apiMessageKey] = "";
-    }
+    MessageText* message = (isShowingConnectMessage == false) ? currentMessage : nullptr;
 
-    responseJSON[apiColorKey] = settings.colors.currentIndex();
-    responseJSON[apiSpeedKey] = settings.scrollDelays.currentIndex();
-    responseJSON[apiBrightnessKey] = settings.brightnessValues.currentIndex();
-    responseJSON[apiDisplayRotationKey] = settings.displayRotations.currentIndex();
-    responseJSON[apiFontKey] = settings.fonts.currentIndex();
+    // Like the main page, the document goes out a chunk at a time. It keeps
+    // its own reference to the message until it's been sent.
+    SettingsAPI::SettingsDocument document(settings, message);
 
-    // According to the arduino json assistant (https://arduinojson.org/v7/assistant/#/step1),
-    // our current model will use 145 bytes + the size of the message buffer.
-    // Since the message buffer length is capped at 512 bytes, the largest
-    // possible payload we'd send would be 657 bytes.
-    // We'll use 1k to allow for a litle bit of breathing room.
-    const int jsonOutputBufferSize = 1024;
-    char jsonOutputBuffer[jsonOutputBufferSize];
-    int bytesSerialized = serializeJson(responseJSON, jsonOutputBuffer, jsonOutputBufferSize);
+    AsyncWebServerResponse *response = request->beginChunkedResponse("application/json", [document](uint8_t* buffer, size_t maxLen, size_t index) mutable -> size_t {
+        return document.read(buffer, maxLen);
+    });
+
+    request->send(response);
+}
 
-    LOGFMT("serialized json output size: %d\n\r", bytesSerialized);
+void MarqueeServer::sendPlaylistResponse(AsyncWebServerRequest *request) {
+    AsyncResponseStream *stream = request->beginResponseStream("application/json");
 
-    if (bytesSerialized >= 0 && bytesSerialized < jsonOutputBufferSize) {
-        AsyncWebServerResponse *response = request->beginResponse(200, "application/json", jsonOutputBuffer);
-        request->send(response);        
+    if (SettingsAPI::serializePlaylist(currentPlaylist, *stream) > 0) {
+        request->send(stream);
     } else {
-        LOGLN("Error serializing settings");
+        LOGLN("Error serializing playlist");
+        delete stream;
         AsyncWebServerResponse *response = request->beginResponse(500, "text/html", internal_error_html);
-        request->send(response);            
-    }    
+        request->send(response);
+    }
 }
 
-void MarqueeServer::apiSetMessage(const char* message) {
-    if (message != nullptr && strlen(message) > 0 && strcmp(message, marquee.getMessage()) != 0) {
-        char decoded[MarqueeController::messageBufferSize];
+bool MarqueeServer::apiSetMessage(const char* message) {
+    const char* current = (currentMessage != nullptr) ? currentMessage->c_str() : "";
+
+    if (message == nullptr || strlen(message) == 0 || strcmp(message, current) == 0) {
+        return true;
+    }
 
-        // Returns true if the full message was decoded, or false if the buffer was not
-        // big enough to contain the entire message. Either way, the decoded message 
-        // string is null terminated, so it is safe to use.
-        bool transliterateResult = transliterateUTF8(message, decoded, MarqueeController::messageBufferSize);
+    // Decoded straight into the text the marquee will share, truncated at
+    // maxMessageLength. Nothing is copied onto the stack.
+    MessageText* decoded = MessageText::fromUTF8(message, MarqueeController::maxMessageLength);
 
-        // CAREFUL: Arduino's serial library has a small buffer size
-        // for printing messages, and printing out large strings can crash the firmware!
-        // This is why we only log the number of bytes decoded below, rather than the entire string.
-        if (transliterateResult) {
-            LOGFMT("   message decoded: %d bytes\n\r", strlen(decoded));
-        } else {
-            LOGFMT("   partial message decoded: %d bytes\n\r", strlen(decoded));
-        }
-        
-        marquee.setMessage(decoded);
+    if (decoded == nullptr) {
+        LOGLN("   not enough memory for the message, dropped");
+        return false;
+    }
+
+    // CAREFUL: Arduino's serial library has a small buffer size
+    // for printing messages, and printing out large strings can crash the firmware!
+    // This is why we only log the number of bytes decoded below, rather than the entire string.
+    LOGFMT("   message decoded: %d bytes\n\r", strlen(decoded->c_str()));
+
+    const bool posted = setCurrentMessage(decoded);
+
+    if (posted) {
         isShowingConnectMessage = false;
-        renderer.setDirty();
     }
+
+    decoded->release();
+    return posted;
+}
+
+bool MarqueeServer::setCurrentMessage(MessageText* message) {
+    if (!marquee.postMessage(message)) {
+        LOGLN("   marquee command queue is full, message dropped");
+        return false;
+    }
+
+    // Keep a reference for the API. The text never changes, so sharing it with the render task is safe.
+    if (currentMessage != nullptr) {
+        currentMessage->release();
+    }
+
+    currentMessage = message->retain();
+
+    // The marquee stops the playlist to show a new message.
+    if (currentPlaylist != nullptr) {
+        currentPlaylist->release();
+        currentPlaylist = nullptr;
+    }
+
+    return true;
+}
+
+bool MarqueeServer::apiSetPlaylist(JsonArrayConst items) {
+    Playlist* playlist = nullptr;
+
+    if (items.size() > 0) {
+        playlist = Playlist::create();
+
+        if (playlist == nullptr) {
+            LOGLN("   not enough memory for the playlist, dropped");
+            return false;
+        }
+
+        for (JsonObjectConst json : items) {
+            const char* message = json[SettingsAPI::messageKey];
+
+            if (message == nullptr || strlen(message) == 0) {
+                continue;
+            }
+
+            if (playlist->count() == Playlist::maxItems) {
+                LOGFMT("   playlist is limited to %d items, the rest dropped\n\r", Playlist::maxItems);
+                break;
+            }
+
+            MessageText* decoded = MessageText::fromUTF8(message, MarqueeController::maxMessageLength);
+
+            if (decoded == nullptr) {
+                LOGLN("   not enough memory for a playlist message, dropped");
+                continue;
+            }
+
+            // Settings that are missing or out of range are taken from the current ones.
+            Playlist::Item item;
+            item.message = decoded;
+            item.fontIndex = json[SettingsAPI::fontKey] | settings.fonts.currentIndex();
+            item.colorIndex = json[SettingsAPI::colorKey] | settings.colors.currentIndex();
+            item.repeat = constrain(json[SettingsAPI::repeatKey] | 1, 1, 255);
+
+            if (item.fontIndex >= settings.fonts.count()) {
+                item.fontIndex = settings.fonts.currentIndex();
+            }
+
+            if (item.colorIndex >= settings.colors.count()) {
+                item.colorIndex = settings.colors.currentIndex();
+            }
+
+            item.fontID = Font::ID(settings.fonts.get(item.fontIndex).value);
+            item.color = Color::RGB::fromHexString(settings.colors.get(item.colorIndex).hexString);
+
+            playlist->add(item);
+            decoded->release();
+        }
+
+        LOGFMT("   playlist: %d items\n\r", playlist->count());
+
+        // Nothing usable in it, so it's treated as empty.
+        if (playlist->count() == 0) {
+            playlist->release();
+            playlist = nullptr;
+        }
+    }
+
+    if (!marquee.postPlaylist(playlist)) {
+        LOGLN("   marquee command queue is full, playlist dropped");
+
+        if (playlist != nullptr) {
+            playlist->release();
+        }
+
+        return false;
+    }
+
+    // Kept for the API, like the message. The marquee has its own reference.
+    if (currentPlaylist != nullptr) {
+        currentPlaylist->release();
+    }
+
+    currentPlaylist = playlist;
+    return true;
 }
 
-void MarqueeServer::apiSetColor(uint8_t index) {
-    if (settings.colors.setIndex(index)) {
-        LOGFMT("   color index: %d, name: %s, value: %s\n\r", index, settings.colors.current().name, settings.colors.current().hexString);
+bool MarqueeServer::apiSetColor(uint8_t index) {
+    if (!settings.colors.isChange(index)) {
+        return true;
+    }
+
+    const Color::RGB rgb = Color::RGB::fromHexString(settings.colors.get(index).hexString);
 
-        const Color::RGB rgb = Color::RGB::fromHexString(settings.colors.current().hexString);
-        marquee.setColor(rgb);
-        renderer.setDirty();
+    if (!marquee.postColor(rgb)) {
+        LOGLN("   marquee command queue is full, color dropped");
+        return false;
     }
+
+    settings.colors.setIndex(index);
+    LOGFMT("   color index: %d, name: %s, value: %s\n\r", index, settings.colors.current().name, settings.colors.current().hexString);
+    return true;
 }
 
-void MarqueeServer::apiSetBrightness(uint8_t index) {
-    if (settings.brightnessValues.setIndex(index)) {
-        LOGFMT("   brightness index: %d, value: %d\n\r", index, settings.brightnessValues.current().value);
+bool MarqueeServer::apiSetBrightness(uint8_t index) {
+    if (!settings.brightnessValues.isChange(index)) {
+        return true;
+    }
 
-        marquee.setBrightness(settings.brightnessValues.current().value);
-        renderer.setDirty();
+    if (!marquee.postBrightness(settings.brightnessValues.get(index).value)) {
+        LOGLN("   marquee command queue is full, brightness dropped");
+        return false;
     }
+
+    settings.brightnessValues.setIndex(index);
+    LOGFMT("   brightness index: %d, value: %d\n\r", index, settings.brightnessValues.current().value);
+    return true;
 }
 
-void MarqueeServer::apiSetSpeed(uint8_t index) {
-    if (settings.scrollDelays.setIndex(index)) {
-        LOGFMT("   speed index: %d, delay: %d\n\r", index, settings.scrollDelays.current().value);
+bool MarqueeServer::apiSetBrightnessMode(uint8_t index) {
+    if (!settings.brightnessModes.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postHardwareBrightness(settings.brightnessModes.get(index).value != 0)) {
+        LOGLN("   marquee command queue is full, brightness mode dropped");
+        return false;
+    }
 
-        marquee.setScrollDelay(settings.scrollDelays.current().value);
-        renderer.setDirty();
-    }        
+    settings.brightnessModes.setIndex(index);
+    LOGFMT("   brightness mode index: %d, name: %s\n\r", index, settings.brightnessModes.current().name);
+    return true;
 }
-void MarqueeServer::apiSetFont(uint8_t index) {
-    if (settings.fonts.setIndex(index)) {
-        LOGFMT("   font index: %d, name: %s\n\r", index, settings.fonts.current().name);
 
-        marquee.setFontID(Font::ID(index));
-        renderer.setDirty();
+bool MarqueeServer::apiSetSpeed(uint8_t index) {
+    if (!settings.scrollDelays.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postScrollDelay(settings.scrollDelays.get(index).value)) {
+        LOGLN("   marquee command queue is full, speed dropped");
+        return false;
     }
+
+    settings.scrollDelays.setIndex(index);
+    LOGFMT("   speed index: %d, delay: %d\n\r", index, settings.scrollDelays.current().value);
+    return true;
 }
 
-void MarqueeServer::apiSetDisplayRotation(uint8_t index) {
-    if (settings.displayRotations.setIndex(index)) {
-        LOGFMT("   rotation index: %d, name: %s \n\r", index, settings.displayRotations.current().name);
+bool MarqueeServer::apiSetScrollStyle(uint8_t index) {
+    if (!settings.scrollStyles.isChange(index)) {
+        return true;
+    }
 
-        marquee.setRotation(settings.displayRotations.current().value);
-        renderer.setDirty();
+    if (!marquee.postSmoothScrolling(settings.scrollStyles.get(index).value != 0)) {
+        LOGLN("   marquee command queue is full, scroll style dropped");
+        return false;
     }
-}
\ No newline at end of file
+
+    settings.scrollStyles.setIndex(index);
+    LOGFMT("   scroll style index: %d, name: %s\n\r", index, settings.scrollStyles.current().name);
+    return true;
+}
+
+bool MarqueeServer::apiSetShortMessageMode(uint8_t index) {
+    if (!settings.shortMessageModes.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postCenterShortMessages(settings.shortMessageModes.get(index).value != 0)) {
+        LOGLN("   marquee command queue is full, short message mode dropped");
+        return false;
+    }
+
+    settings.shortMessageModes.setIndex(index);
+    LOGFMT("   short message mode index: %d, name: %s\n\r", index, settings.shortMessageModes.current().name);
+    return true;
+}
+
+bool MarqueeServer::apiSetLoopGap(uint8_t index) {
+    if (!settings.loopGaps.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postLoopGap(settings.loopGaps.get(index).value)) {
+        LOGLN("   marquee command queue is full, loop gap dropped");
+        return false;
+    }
+
+    settings.loopGaps.setIndex(index);
+    LOGFMT("   loop gap index: %d, gap: %d\n\r", index, settings.loopGaps.current().value);
+    return true;
+}
+
+bool MarqueeServer::apiSetFont(uint8_t index) {
+    if (!settings.fonts.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postFontID(Font::ID(index))) {
+        LOGLN("   marquee command queue is full, font dropped");
+        return false;
+    }
+
+    settings.fonts.setIndex(index);
+    LOGFMT("   font index: %d, name: %s\n\r", index, settings.fonts.current().name);
+    return true;
+}
+
+bool MarqueeServer::apiSetDisplayRotation(uint8_t index) {
+    if (!settings.displayRotations.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postRotation(settings.displayRotations.get(index).value)) {
+        LOGLN("   marquee command queue is full, rotation dropped");
+        return false;
+    }
+
+    settings.displayRotations.setIndex(index);
+    LOGFMT("   rotation index: %d, name: %s \n\r", index, settings.displayRotations.current().name);
+    return true;
+}
+
+bool MarqueeServer::apiSetColorOrder(uint8_t index) {
+    if (!settings.colorOrders.isChange(index)) {
+        return true;
+    }
+
+    if (!marquee.postColorOrder(settings.colorOrders.get(index).value)) {
+        LOGLN("   marquee command queue is full, color order dropped");
+        return false;
+    }
+
+    settings.colorOrders.setIndex(index);
+    LOGFMT("   color order index: %d, name: %s\n\r", index, settings.colorOrders.current().name);
+    store.save();
+    return true;
+}
+
+bool MarqueeServer::apiSetWhiteBalance(const char* hexString) {
+    if (hexString == nullptr || strlen(hexString) != 7 || hexString[0] != '#') {
+        return true;
+    }
+
+    const Color::RGB balance = Color::RGB::fromHexString(hexString);
+
+    // All channels off would leave nothing to see, or to fix it with.
+    if (balance.isBlack() || balance == settings.whiteBalance) {
+        return true;
+    }
+
+    if (!marquee.postWhiteBalance(balance)) {
+        LOGLN("   marquee command queue is full, white balance dropped");
+        return false;
+    }
+
+    LOGFMT("   white balance: %s\n\r", hexString);
+
+    settings.whiteBalance = balance;
+    store.save();
+    return true;
+}
+
+bool MarqueeServer::apiSetPowerBudget(uint16_t milliamps) {
+    if (milliamps == settings.powerBudget) {
+        return true;
+    }
+
+    if (!marquee.postPowerBudget(milliamps)) {
+        LOGLN("   marquee command queue is full, power budget dropped");
+        return false;
+    }
+
+    LOGFMT("   power budget: %d mA\n\r", milliamps);
+
+    settings.powerBudget = milliamps;
+    store.save();
+    return true;
+}
@@ -2,18 +2,25 @@
 
 #include <Arduino.h>
 #include <ESPAsyncWebServer.h>
+#include <ArduinoJson.h>
 
 #include "Settings.h"
+#include "SettingsStore.h"
 #include "MarqueeController.h"
 #include "WebRenderer.h"
+#include "Metrics.h"
+#include "MessageText.h"
+#include "Playlist.h"
 
 class MarqueeServer {
 public:
-    MarqueeServer(Settings& _settings, MarqueeController& _marquee, WebRenderer& _renderer) :
+    MarqueeServer(Settings& _settings, SettingsStore& _store, MarqueeController& _marquee, WebRenderer& _renderer, Metrics& _metrics) :
         server(80),
         settings(_settings),
+        store(_store),
         marquee(_marquee),
-        renderer(_renderer)
+        renderer(_renderer),
+        metrics(_metrics)
     {
 
     }
@@ -22,22 +29,46 @@ public:
 
 private:
     void addHandlers();
+    void sendIndexPage(AsyncWebServerRequest *request);
+    void sendServiceUnavailable(AsyncWebServerRequest *request);
     void sendSettingsResponse(AsyncWebServerRequest *request);
-    void apiSetMessage(const char* message);
-    void apiSetColor(uint8_t index);
-    void apiSetBrightness(uint8_t index);
-    void apiSetSpeed(uint8_t index);
-    void apiSetFont(uint8_t index);
-    void apiSetDisplayRotation(uint8_t index);
+    void sendPlaylistResponse(AsyncWebServerRequest *request);
+    // The apiSet functions make a change from a request and hand it to the
+    // marquee. They return false if it couldn't be queued, or there wasn't the
+    // memory for it, and then the setting is left as it was, so what's
+    // reported and saved never disagrees with the display.
+    bool apiSetMessage(const char* message);
+    bool setCurrentMessage(MessageText* message);
+    bool apiSetColor(uint8_t index);
+    bool apiSetBrightness(uint8_t index);
+    bool apiSetBrightnessMode(uint8_t index);
+    bool apiSetSpeed(uint8_t index);
+    bool apiSetScrollStyle(uint8_t index);
+    bool apiSetShortMessageMode(uint8_t index);
+    bool apiSetLoopGap(uint8_t index);
+    bool apiSetFont(uint8_t index);
+    bool apiSetDisplayRotation(uint8_t index);
+    bool apiSetColorOrder(uint8_t index);
+    bool apiSetWhiteBalance(const char* hexString);
+    bool apiSetPowerBudget(uint16_t milliamps);
+    bool apiSetPlaylist(JsonArrayConst items);
     
 private:
     AsyncWebServer server;
     Settings& settings;
+    SettingsStore& store;
     MarqueeController& marquee;    
     WebRenderer& renderer;
+    Metrics& metrics;
 
     IPAddress localIP;
     IPAddress subnetMask;
 
+    // The last message handed to the marquee. The text is shared with it, not copied.
+    MessageText* currentMessage = nullptr;
+
+    // The playlist handed to the marquee, if it's still playing. Shared the same way.
+    Playlist* currentPlaylist = nullptr;
+
     bool isShowingConnectMessage = true;
 };
\ No newline at end of file
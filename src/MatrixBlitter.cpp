@@ -0,0 +1,102 @@
+#include "MatrixBlitter.h"
+#include <utility>
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+MatrixBlitter::MatrixBlitter(Adafruit_IS31FL3741_QT_buffered& matrix) :
+    matrix(matrix)
+{
+    learnLayout();
+}
+
+void MatrixBlitter::learnLayout() {
+    uint8_t* buffer = matrix.getBuffer();
+    uint8_t saved[bufferSize];
+    memcpy(saved, buffer, bufferSize);
+
+    const uint8_t rotation = matrix.getRotation();
+    matrix.setRotation(0);
+
+    for (int16_t y = 0; y < nativeHeight; y++) {
+        for (int16_t x = 0; x < nativeWidth; x++) {
+            LED& led = leds[y * nativeWidth + x];
+            led.r = probe(x, y, 0xF800);
+            led.g = probe(x, y, 0x07E0);
+            led.b = probe(x, y, 0x001F);
+        }
+    }
+
+    matrix.setRotation(rotation);
+    memcpy(buffer, saved, bufferSize);
+}
+
+void MatrixBlitter::setColorOrder(uint8_t order) {
+    const uint8_t rOffset = (order >> 4) & 3;
+    const uint8_t gOffset = (order >> 2) & 3;
+    const uint8_t bOffset = order & 3;
+
+    // Has to be a permutation of the three channels.
+    if (((1 << rOffset) | (1 << gOffset) | (1 << bOffset)) != 0x07) {
+        LOGFMT("Invalid color order 0x%02x\n\r", order);
+        return;
+    }
+
+    for (LED& led : leds) {
+        // Whatever order they're in now, an LED's channels are its three bytes
+        // of the buffer, so sorting their addresses gives them in buffer order.
+        uint8_t* channels[3] = {led.r, led.g, led.b};
+
+        if (channels[0] == &unused || channels[1] == &unused || channels[2] == &unused) {
+            continue;
+        }
+
+        for (uint8_t i = 1; i < 3; i++) {
+            for (uint8_t j = i; j > 0 && channels[j - 1] > channels[j]; j--) {
+                std::swap(channels[j - 1], channels[j]);
+            }
+        }
+
+        led.r = channels[rOffset];
+        led.g = channels[gOffset];
+        led.b = channels[bOffset];
+    }
+}
+
+void MatrixBlitter::writeScaling(const Color::RGB& balance, uint8_t* scaling) const {
+    const uint8_t* buffer = matrix.getBuffer();
+
+    // Anything not in the table keeps full scale, like the driver's setLEDscaling(255).
+    memset(scaling, 0xFF, bufferSize);
+
+    for (const LED& led : leds) {
+        if (led.r != &unused) {
+            scaling[led.r - buffer] = balance.r;
+        }
+
+        if (led.g != &unused) {
+            scaling[led.g - buffer] = balance.g;
+        }
+
+        if (led.b != &unused) {
+            scaling[led.b - buffer] = balance.b;
+        }
+    }
+}
+
+uint8_t* MatrixBlitter::probe(int16_t x, int16_t y, uint16_t color) {
+    uint8_t* buffer = matrix.getBuffer();
+
+    memset(buffer, 0, bufferSize);
+    matrix.drawPixel(x, y, color);
+
+    for (uint16_t i = 0; i < bufferSize; i++) {
+        if (buffer[i] != 0) {
+            return buffer + i;
+        }
+    }
+
+    LOGFMT("No LED channel for pixel %d, %d\n\r", x, y);
+    return &unused;
+}
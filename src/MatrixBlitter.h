@@ -0,0 +1,119 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_IS31FL3741.h>
+#include "Color.h"
+
+// Writes pixels straight into the matrix driver's buffer, skipping the virtual
+// drawPixel, bounds checks and rotation switch that Adafruit_GFX does for
+// every pixel. Each rotation is a template parameter, so the callers' inner
+// loops compile down to fixed strides through a table of LED addresses.
+//
+// Colors are written at their full 8 bits per channel, rather than going
+// through the 565 values that drawPixel takes. The table is learned from the
+// driver when the blitter is constructed, by drawing single pixels and seeing
+// which bytes change.
+//
+// The LEDs' color order can be changed at runtime with setColorOrder(). That
+// permutes the table's channel addresses once, so every order writes pixels
+// through the same code, with nothing per pixel to decide.
+class MatrixBlitter {
+public:
+    // The Adafruit LED Glasses / QT matrix, unrotated.
+    static constexpr int16_t nativeWidth = 13;
+    static constexpr int16_t nativeHeight = 9;
+    static constexpr uint16_t ledCount = nativeWidth * nativeHeight;
+    static constexpr uint16_t bufferSize = ledCount * 3;
+
+    // Size and addressing of the display in one rotation (same meaning as Adafruit_GFX::setRotation).
+    template <uint8_t rotation>
+    struct Layout {
+        static constexpr int16_t width = (rotation & 1) ? nativeHeight : nativeWidth;
+        static constexpr int16_t height = (rotation & 1) ? nativeWidth : nativeHeight;
+
+        // LED index of the top pixel of column x.
+        static constexpr int16_t columnStart(int16_t x) {
+            return rotation == 0 ? x
+                : rotation == 1 ? x * nativeWidth + (nativeWidth - 1)
+                : rotation == 2 ? (nativeHeight - 1) * nativeWidth + (nativeWidth - 1) - x
+                : (nativeHeight - 1 - x) * nativeWidth;
+        }
+
+        // Difference in LED index between a pixel and the one below it.
+        static constexpr int16_t rowStep = rotation == 0 ? nativeWidth
+            : rotation == 1 ? -1
+            : rotation == 2 ? -nativeWidth
+            : 1;
+    };
+
+public:
+    explicit MatrixBlitter(Adafruit_IS31FL3741_QT_buffered& matrix);
+
+    // Same as the driver's fill(0).
+    inline void clear() {
+        memset(matrix.getBuffer(), 0, bufferSize);
+    }
+
+    // Sets every LED to color.
+    void fill(const Color::RGB& color) {
+        for (const LED& led : leds) {
+            write(led, color);
+        }
+    }
+
+    // Writes each LED's red, green and blue to its channels in order (one of
+    // the IS3741_order values), whatever order the driver was constructed
+    // with. Other values are ignored.
+    void setColorOrder(uint8_t order);
+
+    // Fills scaling, laid out like the driver's buffer, with each LED's red,
+    // green and blue scale from balance. These are for the chip's LED scaling
+    // registers, which sit in front of the PWM registers, so the balance costs
+    // nothing per frame. They follow the color order, so they have to be
+    // redone when it changes.
+    void writeScaling(const Color::RGB& balance, uint8_t* scaling) const;
+
+    // (x, y) must be on the display.
+    template <uint8_t rotation>
+    inline void drawPixel(int16_t x, int16_t y, const Color::RGB& color) {
+        write(leds[Layout<rotation>::columnStart(x) + y * Layout<rotation>::rowStep], color);
+    }
+
+    // Lights the rows of column x set in mask, bit 0 at the top. x must be on the
+    // display; rows below the bottom are ignored.
+    template <uint8_t rotation>
+    inline void drawColumn(int16_t x, uint16_t mask, const Color::RGB& color) {
+        const LED* led = leds + Layout<rotation>::columnStart(x);
+        mask &= (1 << Layout<rotation>::height) - 1;
+
+        for (; mask != 0; mask >>= 1, led += Layout<rotation>::rowStep) {
+            if (mask & 1) {
+                write(*led, color);
+            }
+        }
+    }
+
+private:
+    // Where each channel of one LED lives in the driver's buffer.
+    struct LED {
+        uint8_t* r;
+        uint8_t* g;
+        uint8_t* b;
+    };
+
+    static inline void write(const LED& led, const Color::RGB& color) {
+        *led.r = color.r;
+        *led.g = color.g;
+        *led.b = color.b;
+    }
+
+    void learnLayout();
+    uint8_t* probe(int16_t x, int16_t y, uint16_t color);
+
+private:
+    Adafruit_IS31FL3741_QT_buffered& matrix;
+    LED leds[ledCount];
+
+    // Channels drawPixel doesn't touch are written here instead.
+    uint8_t unused = 0;
+};
@@ -0,0 +1,143 @@
+#include "MessageRaster.h"
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+MessageRaster::~MessageRaster() {
+    if (text != nullptr) {
+        text->release();
+    }
+}
+
+void MessageRaster::setText(MessageText* newText) {
+    if (newText != nullptr) {
+        newText->retain();
+    }
+
+    if (text != nullptr) {
+        text->release();
+    }
+
+    text = newText;
+    textLength = 0;
+    textWidth = 0;
+    laidOut = false;
+    restart();
+}
+
+void MessageRaster::setFontID(Font::ID id) {
+    fontID = id;
+    textLength = 0;
+    textWidth = 0;
+    laidOut = false;
+    restart();
+}
+
+void MessageRaster::setColor(const Color::RGB& newColor) {
+    color = newColor;
+    updateSolidColor();
+}
+
+void MessageRaster::updateLevels() {
+    updateSolidColor();
+}
+
+void MessageRaster::updateSolidColor() {
+    // Only the hue and saturation are kept; the brightness setting replaces the color's own.
+    solidColor = levels.apply(color.atFullValue());
+    dirty = true;
+}
+
+bool MessageRaster::layout(uint32_t maxCharacters) {
+    if (laidOut) {
+        return true;
+    }
+
+    // Nothing is kept per glyph, just the running totals.
+    const Font& font = Font::withID(fontID);
+    const char* chars = getText();
+
+    for (uint32_t i = 0; i < maxCharacters; i++) {
+        const char c = chars[textLength];
+
+        if (c == 0) {
+            laidOut = true;
+            break;
+        }
+
+        textWidth += font.charWidth(c);
+        textLength++;
+    }
+
+    return laidOut;
+}
+
+void MessageRaster::rasterize(int32_t left, int32_t right) {
+    const Font& font = Font::withID(fontID);
+    const uint32_t glyphs = glyphCount();
+
+    // The window only moves right through the message (until restart()),
+    // so glyphs that end before it can be left behind for good.
+    while (anchorGlyph < glyphs && anchorX + maxGlyphExtent <= left) {
+        anchorX += glyphAdvance(font, anchorGlyph);
+        anchorGlyph++;
+    }
+
+    if (dirty) {
+        ring.reset(min(anchorX, left));
+        nextGlyph = anchorGlyph;
+        nextGlyphX = anchorX;
+        dirty = false;
+    }
+
+    // Glyphs never reach left of their origin, so every column before the
+    // cursor is complete once it has passed.
+    while (nextGlyph < glyphs && nextGlyphX < right) {
+        rasterizeGlyph(nextGlyph, nextGlyphX);
+        nextGlyphX += glyphAdvance(font, nextGlyph);
+        nextGlyph++;
+    }
+
+    ring.extend(right);
+}
+
+int32_t MessageRaster::dropFirstCopy() {
+    // The anchor is the first glyph the window can still reach.
+    if (!isLooping() || anchorGlyph < textLength) {
+        return 0;
+    }
+
+    const int32_t period = textWidth + loopGap;
+
+    anchorGlyph -= textLength;
+    anchorX -= period;
+    nextGlyph -= textLength;
+    nextGlyphX -= period;
+    ring.rebase(period);
+
+    // Glyph numbers set the rainbow's hue, so it starts from where the second copy's did.
+    startHue = (startHue + (textLength * hueStep)) & 0xFFFF;
+
+    return period;
+}
+
+void MessageRaster::rasterizeGlyph(uint32_t index, int32_t x) {
+    const Font& font = Font::withID(fontID);
+    const uint8_t c = getText()[characterIndex(index)];
+    const int16_t yOffset = font.yOffset + lineTop;
+
+    ring.extend(x + maxGlyphExtent);
+
+    if (ColumnFont::contains(c)) {
+        const ColumnFont& columnFont = *font.columnFont;
+        const ColumnFont::Glyph& glyph = columnFont.glyph(c);
+        ring.drawColumns(x + glyph.x, yOffset + columnFont.top, columnFont.glyphColumns(glyph), glyph.width, characterColor(index));
+    } else {
+        ring.setOrigin(x);
+        ring.setFont(font.gfxFont);
+        ring.setCursor(0, yOffset);
+        ring.setGlyphColor(characterColor(index));
+        ring.write(c);
+    }
+}
@@ -0,0 +1,198 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Font.h"
+#include "Color.h"
+#include "ColumnRing.h"
+#include "MessageText.h"
+
+// A message as the marquee shows it: laid out in one font and color, and
+// rasterized into a ColumnRing a glyph at a time as the visible window scrolls
+// through it. Laying out (measuring the width) is the only part that grows
+// with the length of the text, so it can be done in slices. That lets the
+// marquee get the next message ready between frames while showing another.
+class MessageRaster {
+public:
+    // Widest a glyph's bitmap reaches from its origin, in any of our fonts.
+    static constexpr int32_t maxGlyphExtent = 8;
+
+    // Rainbow text changes hue by this much per character.
+    static constexpr uint16_t hueStep = (65536 / 12);
+
+public:
+    MessageRaster(const Color::RainbowTable& rainbowTable, const Color::LevelTable& levels) :
+        rainbowTable(rainbowTable),
+        levels(levels)
+    {
+
+    }
+
+    ~MessageRaster();
+
+    // Takes a reference to text (nullptr for none) and starts its layout over.
+    void setText(MessageText* text);
+
+    const char* getText() const {
+        return (text != nullptr) ? text->c_str() : "";
+    }
+
+    void setFontID(Font::ID id);
+
+    Font::ID getFontID() const {
+        return fontID;
+    }
+
+    // Black selects the rainbow.
+    void setColor(const Color::RGB& newColor);
+
+    const Color::RGB& getColor() const {
+        return color;
+    }
+
+    // Picks up a new brightness in the level table.
+    void updateLevels();
+
+    // Hue of the first character in rainbow mode.
+    void setStartHue(uint16_t hue) {
+        startHue = hue;
+        dirty = true;
+    }
+
+    // Row that the top of a Font::lineHeight line sits on.
+    void setLineTop(int16_t top) {
+        lineTop = top;
+        dirty = true;
+    }
+
+    // Measures up to maxCharacters more of the text. Returns true once all of it is laid out.
+    bool layout(uint32_t maxCharacters);
+
+    void layoutAll() {
+        layout(UINT32_MAX);
+    }
+
+    bool isLaidOut() const {
+        return laidOut;
+    }
+
+    // Only final once isLaidOut().
+    uint32_t length() const {
+        return textLength;
+    }
+
+    int32_t width() const {
+        return textWidth;
+    }
+
+    // Moves the window back to the start of the message.
+    void restart() {
+        anchorGlyph = 0;
+        anchorX = 0;
+        dirty = true;
+    }
+
+    // Starts the message over, with the rainbow carrying on from where its last character left off.
+    void wrap() {
+        startHue = (startHue + (textLength * hueStep)) & 0xFFFF;
+        restart();
+    }
+
+    // With a gap, copies of the message follow each other endlessly, gap
+    // columns apart, like a strip of it joined into a loop. 0 is a single copy.
+    void setLoopGap(uint8_t gap) {
+        if (gap != loopGap) {
+            loopGap = gap;
+            dirty = true;
+        }
+    }
+
+    uint8_t getLoopGap() const {
+        return loopGap;
+    }
+
+    // Once a looping message's window has moved wholly past its first copy,
+    // renumbers the columns so the second copy is the first, and returns how
+    // far they moved. Otherwise returns 0. Column numbers stay small however
+    // long the message loops, and nothing is redrawn.
+    int32_t dropFirstCopy();
+
+    // True when the ring has to be redrawn before it can be shown.
+    bool isDirty() const {
+        return dirty;
+    }
+
+    // Makes sure columns left to right - 1 are in the ring. The window may only
+    // move right between calls, unless restart() is called in between.
+    void rasterize(int32_t left, int32_t right);
+
+    inline uint16_t columnMask(int32_t column) const {
+        return ring.mask(column);
+    }
+
+    inline const Color::RGB& columnColor(int32_t column) const {
+        return ring.color(column);
+    }
+
+private:
+    void rasterizeGlyph(uint32_t index, int32_t x);
+    void updateSolidColor();
+
+    inline bool isLooping() const {
+        return loopGap != 0 && laidOut && textLength != 0;
+    }
+
+    // Glyphs are numbered on through the copies of a looping message.
+    inline uint32_t glyphCount() const {
+        return isLooping() ? UINT32_MAX : textLength;
+    }
+
+    inline uint32_t characterIndex(uint32_t glyph) const {
+        return (glyph < textLength) ? glyph : glyph % textLength;
+    }
+
+    // How far the glyph moves the cursor on, including the gap after the last one of a copy.
+    inline int32_t glyphAdvance(const Font& font, uint32_t glyph) const {
+        const uint32_t index = characterIndex(glyph);
+        const int32_t advance = font.charWidth(getText()[index]);
+        return (index == textLength - 1) ? advance + loopGap : advance;
+    }
+
+    // The rainbow carries on through the copies.
+    inline Color::RGB characterColor(uint32_t glyph) const {
+        if (color.isBlack()) {
+            return levels.apply(rainbowTable.colorForHue(startHue + (glyph * hueStep)));
+        }
+
+        return solidColor;
+    }
+
+private:
+    const Color::RainbowTable& rainbowTable;
+    const Color::LevelTable& levels;
+
+    MessageText* text = nullptr;
+    Font::ID fontID = Font::ID::adafruit;
+    Color::RGB color;
+    Color::RGB solidColor;
+    uint16_t startHue = 0;
+    int16_t lineTop = 0;
+    uint8_t loopGap = 0;
+
+    // Layout, as far as it has got.
+    uint32_t textLength = 0;
+    int32_t textWidth = 0;
+    bool laidOut = true;
+
+    // Columns around the visible window. The anchor is the first glyph that can
+    // still reach the window, and the raster cursor is the next glyph to draw
+    // into the ring.
+    ColumnRing ring;
+    uint32_t anchorGlyph = 0;
+    int32_t anchorX = 0;
+    uint32_t nextGlyph = 0;
+    int32_t nextGlyphX = 0;
+
+    // Set by anything that changes how the message looks. The ring is redrawn
+    // from the anchor on the next rasterize().
+    bool dirty = true;
+};
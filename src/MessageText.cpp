@@ -0,0 +1,64 @@
+#include "MessageText.h"
+#include <new>
+#include "transliterateUTF8.h"
+
+#if defined(BOARD_HAS_PSRAM)
+#include <esp_heap_caps.h>
+#endif
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+MessageText* MessageText::create(size_t maxLength) {
+    const size_t size = sizeof(MessageText) + maxLength;
+
+#if defined(BOARD_HAS_PSRAM)
+    // Long messages are only read a few characters per frame, so slower memory is fine.
+    void* memory = heap_caps_malloc(size, MALLOC_CAP_SPIRAM | MALLOC_CAP_8BIT);
+
+    if (memory == nullptr) {
+        memory = malloc(size);
+    }
+#else
+    void* memory = malloc(size);
+#endif
+
+    if (memory == nullptr) {
+        LOGFMT("Not enough memory for a %d character message\n\r", maxLength);
+        return nullptr;
+    }
+
+    return new (memory) MessageText();
+}
+
+MessageText* MessageText::copy(const char* str, size_t maxLength) {
+    const size_t length = strnlen(str, maxLength);
+    MessageText* message = create(length);
+
+    if (message != nullptr) {
+        memcpy(message->text, str, length);
+        message->text[length] = 0;
+    }
+
+    return message;
+}
+
+MessageText* MessageText::fromUTF8(const char* utf8, size_t maxLength) {
+    const size_t length = min(transliteratedLength(utf8), maxLength);
+    MessageText* message = create(length);
+
+    // Truncation is fine here; the result is null terminated either way.
+    if (message != nullptr) {
+        transliterateUTF8(utf8, message->text, length + 1);
+    }
+
+    return message;
+}
+
+void MessageText::release() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        this->~MessageText();
+        free(this);
+    }
+}
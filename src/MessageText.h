@@ -0,0 +1,46 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// Immutable message text, reference counted so the web server and the marquee
+// share one copy however long the message is. It's allocated in PSRAM when the
+// board has some. Whoever holds a pointer owns one reference and has to
+// release() it when done.
+class MessageText {
+public:
+    // Room for maxLength characters plus the terminator, starting out empty.
+    // These return nullptr if there isn't enough memory.
+    static MessageText* create(size_t maxLength);
+
+    // Copies at most maxLength characters of str.
+    static MessageText* copy(const char* str, size_t maxLength);
+
+    // Transliterates UTF-8 into the ASCII the marquee can show, truncated at maxLength characters.
+    static MessageText* fromUTF8(const char* utf8, size_t maxLength);
+
+    inline MessageText* retain() {
+        refs.fetch_add(1, std::memory_order_relaxed);
+        return this;
+    }
+
+    void release();
+
+    inline const char* c_str() const {
+        return text;
+    }
+
+    // Only for filling in a new text, before it's shared.
+    inline char* data() {
+        return text;
+    }
+
+private:
+    MessageText() = default;
+
+private:
+    std::atomic<uint32_t> refs{1};
+
+    // Allocated with as much room after it as the text needs.
+    char text[1] = {0};
+};
@@ -0,0 +1,132 @@
+#include "Metrics.h"
+
+namespace {
+    struct RouteInfo {
+        const char* path;
+        const char* method;
+    };
+
+    // In the same order as Metrics::Route
+    const RouteInfo routes[] = {
+        {"/", "GET"},
+        {"/update", "POST"},
+        {"/settings", "GET"},
+        {"/settings", "POST"},
+        {"/playlist", "GET"},
+        {"/playlist", "POST"},
+        {"/styles.css", "GET"},
+        {"/metrics", "GET"},
+        {"other", "ANY"},
+    };
+
+    static_assert(sizeof(routes) / sizeof(routes[0]) == uint8_t(Metrics::Route::count), "Missing route info");
+
+    void writeHeader(Print& out, const char* name, const char* type, const char* help) {
+        out.printf("# HELP %s %s\n", name, help);
+        out.printf("# TYPE %s %s\n", name, type);
+    }
+
+    void writeCounter(Print& out, const char* name, const char* help, uint32_t value) {
+        writeHeader(out, name, "counter", help);
+        out.printf("%s %u\n", name, value);
+    }
+
+    void writeGauge(Print& out, const char* name, const char* help, uint32_t value) {
+        writeHeader(out, name, "gauge", help);
+        out.printf("%s %u\n", name, value);
+    }
+
+    // Prometheus wants seconds; print microseconds as a fixed-point decimal.
+    void writeSeconds(Print& out, uint32_t micros) {
+        out.printf("%u.%06u", micros / 1000000, micros % 1000000);
+    }
+}
+
+const uint32_t Metrics::Histogram::bucketBounds[Metrics::Histogram::bucketCount] = {
+    50, 100, 250, 500, 1000, 2500, 5000, 10000, 20000, 30000, 50000, 100000
+};
+
+void Metrics::Histogram::record(uint32_t micros) {
+    uint8_t bucket = 0;
+
+    while (bucket < bucketCount && micros > bucketBounds[bucket]) {
+        bucket++;
+    }
+
+    buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    sum.fetch_add(micros, std::memory_order_relaxed);
+    total.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Metrics::Histogram::write(Print& out, const char* name, const char* labels) const {
+    // Labels go before "le" in each bucket, and on their own on the sum and count.
+    const char* separator = (labels != nullptr) ? "," : "";
+    labels = (labels != nullptr) ? labels : "";
+
+    uint32_t cumulative = 0;
+
+    for (uint8_t i = 0; i < bucketCount; i++) {
+        cumulative += buckets[i].load(std::memory_order_relaxed);
+        out.printf("%s_bucket{%s%sle=\"", name, labels, separator);
+        writeSeconds(out, bucketBounds[i]);
+        out.printf("\"} %u\n", cumulative);
+    }
+
+    cumulative += buckets[bucketCount].load(std::memory_order_relaxed);
+    out.printf("%s_bucket{%s%sle=\"+Inf\"} %u\n", name, labels, separator, cumulative);
+
+    if (labels[0] != 0) {
+        out.printf("%s_sum{%s} ", name, labels);
+    } else {
+        out.printf("%s_sum ", name);
+    }
+
+    writeSeconds(out, sum.load(std::memory_order_relaxed));
+
+    // Use the bucket total as the count, so it always agrees with the +Inf bucket.
+    if (labels[0] != 0) {
+        out.printf("\n%s_count{%s} %u\n", name, labels, cumulative);
+    } else {
+        out.printf("\n%s_count %u\n", name, cumulative);
+    }
+}
+
+void Metrics::writePrometheus(Print& out) const {
+    writeHeader(out, "marquee_compose_seconds", "histogram", "Time to compose a frame.");
+    composeTime.write(out, "marquee_compose_seconds");
+
+    writeHeader(out, "marquee_show_seconds", "histogram", "Time to send a frame to the display.");
+    showTime.write(out, "marquee_show_seconds");
+
+    writeHeader(out, "marquee_frame_jitter_seconds", "histogram", "Difference between the actual and intended time between frames.");
+    frameJitter.write(out, "marquee_frame_jitter_seconds");
+
+    writeCounter(out, "marquee_frames_total", "Frames composed.", frames.get());
+    writeCounter(out, "marquee_idle_frames_total", "Frames skipped because the display already showed them.", idleFrames.get());
+    writeCounter(out, "marquee_skipped_frames_total", "Frames skipped because the render task was late for them.", skippedFrames.get());
+    writeCounter(out, "marquee_missed_deadlines_total", "Frames that started late.", missedDeadlines.get());
+    writeCounter(out, "marquee_display_bytes_sent_total", "Bytes sent to the display over I2C.", displayBytesSent.get());
+    writeCounter(out, "marquee_display_bytes_saved_total", "Bytes not sent because the registers were unchanged.", displayBytesSaved.get());
+
+    writeGauge(out, "marquee_led_current_milliamps", "Estimated LED current of the last frame.", ledCurrent.get());
+    writeGauge(out, "marquee_power_budget_milliamps", "LED current the power limiter keeps under, 0 for none.", powerBudget.get());
+    writeGauge(out, "marquee_max_global_current", "Highest global current the power limiter allows, 0-255.", maxGlobalCurrent.get());
+    writeCounter(out, "marquee_power_limited_frames_total", "Frames dimmed by the power limiter.", powerLimitedFrames.get());
+
+    writeHeader(out, "marquee_http_requests_total", "counter", "HTTP requests handled.");
+
+    for (uint8_t i = 0; i < uint8_t(Route::count); i++) {
+        out.printf("marquee_http_requests_total{route=\"%s\",method=\"%s\"} %u\n", routes[i].path, routes[i].method, requestTime[i].count());
+    }
+
+    writeHeader(out, "marquee_http_request_seconds", "histogram", "Time spent in the HTTP request handler.");
+
+    for (uint8_t i = 0; i < uint8_t(Route::count); i++) {
+        char labels[48];
+        snprintf(labels, sizeof(labels), "route=\"%s\",method=\"%s\"", routes[i].path, routes[i].method);
+        requestTime[i].write(out, "marquee_http_request_seconds", labels);
+    }
+
+    writeGauge(out, "marquee_free_heap_bytes", "Free heap.", ESP.getFreeHeap());
+    writeGauge(out, "marquee_min_free_heap_bytes", "Lowest free heap since boot.", ESP.getMinFreeHeap());
+}
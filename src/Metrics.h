@@ -0,0 +1,101 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// Always-on counters and histograms for the frame loop and the web server,
+// exported in Prometheus text format at /metrics. Recording a value is a
+// single relaxed atomic add, so it's safe from any task and never blocks.
+class Metrics {
+public:
+    class Counter {
+    public:
+        inline void increment(uint32_t amount = 1) {
+            value.fetch_add(amount, std::memory_order_relaxed);
+        }
+
+        inline uint32_t get() const {
+            return value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint32_t> value{0};
+    };
+
+    // A value that's set rather than added to, like a current reading.
+    class Gauge {
+    public:
+        inline void set(uint32_t newValue) {
+            value.store(newValue, std::memory_order_relaxed);
+        }
+
+        inline uint32_t get() const {
+            return value.load(std::memory_order_relaxed);
+        }
+
+    private:
+        std::atomic<uint32_t> value{0};
+    };
+
+    // Durations in microseconds, counted into fixed buckets from 50 us to 100 ms.
+    // The sum is 32 bits, so it wraps after about 71 minutes of total recorded time.
+    class Histogram {
+    public:
+        static constexpr uint8_t bucketCount = 12;
+        static const uint32_t bucketBounds[bucketCount];
+
+        void record(uint32_t micros);
+
+        inline uint32_t count() const {
+            return total.load(std::memory_order_relaxed);
+        }
+
+        void write(Print& out, const char* name, const char* labels = nullptr) const;
+
+    private:
+        // One extra bucket for everything above the last bound.
+        std::atomic<uint32_t> buckets[bucketCount + 1] = {};
+        std::atomic<uint32_t> sum{0};
+        std::atomic<uint32_t> total{0};
+    };
+
+    enum class Route : uint8_t {
+        index,
+        update,
+        settingsGet,
+        settingsPost,
+        playlistGet,
+        playlistPost,
+        styles,
+        metrics,
+        notFound,
+        count
+    };
+
+public:
+    // Frame loop
+    Histogram composeTime;
+    Histogram showTime;
+    Histogram frameJitter;
+    Counter frames;
+    Counter idleFrames;
+    Counter skippedFrames;
+    Counter missedDeadlines;
+    Counter displayBytesSent;
+    Counter displayBytesSaved;
+
+    // Power limiter
+    Gauge ledCurrent;
+    Gauge powerBudget;
+    Gauge maxGlobalCurrent;
+    Counter powerLimitedFrames;
+
+    // Web server
+    Histogram requestTime[uint8_t(Route::count)];
+
+    void recordRequest(Route route, uint32_t startMicros) {
+        requestTime[uint8_t(route)].record(micros() - startMicros);
+    }
+
+    void writePrometheus(Print& out) const;
+};
@@ -0,0 +1,60 @@
+#include "PanelChain.h"
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+PanelChain::PanelChain(DisplayPanel* const* chain, uint8_t count) :
+    panelCount((count < maxPanels) ? count : uint8_t(maxPanels))
+{
+    for (uint8_t i = 0; i < panelCount; i++) {
+        panels[i] = chain[i];
+    }
+}
+
+void PanelChain::setRotation(uint8_t r) {
+    for (uint8_t i = 0; i < panelCount; i++) {
+        panels[i]->matrix.setRotation(r);
+    }
+}
+
+void PanelChain::setColorOrder(uint8_t order) {
+    for (uint8_t i = 0; i < panelCount; i++) {
+        panels[i]->blitter.setColorOrder(order);
+    }
+
+    // The scaling registers follow the channels around.
+    scalingChanged = true;
+}
+
+void PanelChain::setWhiteBalance(const Color::RGB& balance) {
+    whiteBalance = balance;
+    scalingChanged = true;
+}
+
+void PanelChain::clear() {
+    for (uint8_t i = 0; i < panelCount; i++) {
+        panels[i]->blitter.clear();
+    }
+}
+
+bool PanelChain::submit(uint8_t globalCurrent) {
+    // Only the render task submits, so panels that are idle now stay idle until they're handed a frame.
+    for (uint8_t i = 0; i < panelCount; i++) {
+        if (!panels[i]->flusher.isIdle()) {
+            return false;
+        }
+    }
+
+    for (uint8_t i = 0; i < panelCount; i++) {
+        if (scalingChanged) {
+            panels[i]->blitter.writeScaling(whiteBalance, scaling);
+        }
+
+        panels[i]->flusher.submit(panels[i]->matrix.getBuffer(), globalCurrent, scalingChanged ? scaling : nullptr);
+    }
+
+    scalingChanged = false;
+
+    return true;
+}
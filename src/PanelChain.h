@@ -0,0 +1,73 @@
+#pragma once
+
+#include <Arduino.h>
+#include "DisplayPanel.h"
+
+// Panels side by side, left to right as seen from the front, making one
+// canvas as wide as all of them. Every panel has the same rotation and shows
+// the canvas columns in front of it.
+//
+// Each panel has its own flusher, and so its own flush task, so frames go out
+// to all of them at once. Panels on different I2C buses are sent truly in
+// parallel; panels sharing a bus take turns a transaction at a time.
+class PanelChain {
+public:
+    // The message's column ring is sized for this many panels' worth of columns.
+    static constexpr uint8_t maxPanels = 4;
+
+public:
+    // Takes the first maxPanels of panels. There has to be at least one.
+    PanelChain(DisplayPanel* const* panels, uint8_t count);
+
+    uint8_t count() const {
+        return panelCount;
+    }
+
+    DisplayPanel& panel(uint8_t index) const {
+        return *panels[index];
+    }
+
+    // Canvas size in the current rotation.
+    int16_t width() const {
+        return panelCount * panels[0]->matrix.width();
+    }
+
+    int16_t height() const {
+        return panels[0]->matrix.height();
+    }
+
+    void setRotation(uint8_t r);
+
+    // See MatrixBlitter::setColorOrder(). All the panels are assumed to be the same kind of matrix.
+    void setColorOrder(uint8_t order);
+
+    // Scales each color channel's LED current, 255 being full current, to
+    // balance the matrices' white. The chips' scaling registers are set with
+    // the next frame submitted.
+    void setWhiteBalance(const Color::RGB& balance);
+
+    const Color::RGB& getWhiteBalance() const {
+        return whiteBalance;
+    }
+
+    // Clears every panel's buffer.
+    void clear();
+
+    // Hands each panel's buffer to its flusher, with the global current for
+    // all of them, and the white balance if it's changed since the last frame.
+    // If any of them is still sending the previous frame, nothing is handed
+    // over and this returns false, so the panels are never more than one
+    // frame apart.
+    bool submit(uint8_t globalCurrent);
+
+private:
+    DisplayPanel* panels[maxPanels];
+    uint8_t panelCount;
+
+    // The chips start out unbalanced, so the first frame sets their scaling too.
+    Color::RGB whiteBalance = 0xFFFFFF;
+    bool scalingChanged = true;
+
+    // Each panel's scaling registers are laid out here in turn, to be copied by its flusher.
+    uint8_t scaling[MatrixBlitter::bufferSize];
+};
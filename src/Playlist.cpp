@@ -0,0 +1,40 @@
+#include "Playlist.h"
+#include <new>
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+Playlist* Playlist::create() {
+    Playlist* playlist = new (std::nothrow) Playlist();
+
+    if (playlist == nullptr) {
+        LOGLN("Not enough memory for a playlist");
+    }
+
+    return playlist;
+}
+
+Playlist::~Playlist() {
+    for (uint8_t i = 0; i < itemCount; i++) {
+        items[i].message->release();
+    }
+}
+
+bool Playlist::add(const Item& item) {
+    if (itemCount == maxItems) {
+        return false;
+    }
+
+    items[itemCount] = item;
+    items[itemCount].repeat = max(item.repeat, uint8_t(1));
+    items[itemCount].message->retain();
+    itemCount++;
+    return true;
+}
+
+void Playlist::release() {
+    if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+#include "Font.h"
+#include "Color.h"
+#include "MessageText.h"
+
+// Messages the marquee cycles through, each scrolled across a number of times
+// in its own font and color. Built by the web server, then shared unchanged
+// with the marquee and reference counted like MessageText: whoever holds a
+// pointer owns one reference and has to release() it when done.
+class Playlist {
+public:
+    static constexpr uint8_t maxItems = 32;
+
+    struct Item {
+        MessageText* message;
+        Font::ID fontID;
+        Color::RGB color;
+
+        // Times the message scrolls across before the next item, at least 1.
+        uint8_t repeat;
+
+        // The web API's setting indexes, to report the playlist back as it was set.
+        uint8_t fontIndex;
+        uint8_t colorIndex;
+    };
+
+public:
+    // Returns nullptr if there isn't enough memory.
+    static Playlist* create();
+
+    // Only for filling in a new playlist, before it's shared. Takes a reference
+    // to the item's message. Returns false if the playlist is full.
+    bool add(const Item& item);
+
+    uint8_t count() const {
+        return itemCount;
+    }
+
+    const Item& item(uint8_t index) const {
+        return items[index];
+    }
+
+    inline Playlist* retain() {
+        refs.fetch_add(1, std::memory_order_relaxed);
+        return this;
+    }
+
+    void release();
+
+private:
+    Playlist() = default;
+    ~Playlist();
+
+private:
+    std::atomic<uint32_t> refs{1};
+    uint8_t itemCount = 0;
+    Item items[maxItems];
+};
@@ -0,0 +1,51 @@
+#include "PowerLimiter.h"
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+namespace {
+    // The highest global current, in 256ths, that keeps a frame drawing
+    // fullCurrent at the full global current under budget (both in microamps).
+    uint16_t fittingCap(uint32_t budget, uint64_t fullCurrent, uint16_t maxCap) {
+        if (fullCurrent == 0) {
+            return maxCap;
+        }
+
+        return min(uint64_t(budget) * maxCap / fullCurrent, uint64_t(maxCap));
+    }
+}
+
+void PowerLimiter::setBudget(uint16_t milliamps) {
+    budget = milliamps;
+
+    if (budget == 0) {
+        cap = maxCap;
+        limiting = false;
+    }
+}
+
+void PowerLimiter::update(uint32_t frameLoad, uint8_t globalCurrent, uint32_t dt) {
+    load = frameLoad;
+
+    // LED current is proportional to PWM, scaling and the global current.
+    const uint64_t fullCurrent = uint64_t(load) * channelMicroamps / (255 * 255);
+
+    if (budget != 0) {
+        const uint32_t budgetMicroamps = uint32_t(budget) * 1000;
+        const uint16_t fit = fittingCap(budgetMicroamps, fullCurrent, maxCap);
+        const uint16_t fitWithMargin = fittingCap(budgetMicroamps - (budgetMicroamps >> releaseMarginShift), fullCurrent, maxCap);
+
+        if (fit < cap) {
+            cap = fit;
+            LOGFMT("power limit: global current capped at %d\n\r", cap >> 8);
+        } else if (fitWithMargin > cap) {
+            const uint32_t step = max(uint32_t(maxCap) * dt / releaseTime, uint32_t(1));
+            cap = min(uint32_t(cap) + step, uint32_t(fitWithMargin));
+        }
+    }
+
+    const uint8_t applied = min(globalCurrent, getMaxGlobalCurrent());
+    limiting = applied < globalCurrent;
+    estimate = fullCurrent * applied / (255 * 1000);
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include <Arduino.h>
+
+// Average current of one LED channel with its PWM, scaling register and the
+// global current all at full, in microamps. The driver's current sources are
+// each shared by nine scan lines, so this is a fraction of their peak. The
+// default is on the safe side; measure a panel lit white to tighten it.
+#if !defined(MARQUEE_LED_CHANNEL_MICROAMPS)
+    #define MARQUEE_LED_CHANNEL_MICROAMPS 4000
+#endif
+
+// Keeps the matrices' LED current under a budget, so a bright message can't
+// brown out a board powered over USB. The current is estimated from each
+// composed frame's PWM values rather than measured, and limited by capping
+// the panels' global current, which the LED current is proportional to.
+//
+// The cap comes down at once when a frame would go over the budget. It only
+// goes back up once frames fit under the budget with some room to spare, and
+// then gradually, so the display doesn't visibly pump as brighter and darker
+// parts of the message scroll past.
+class PowerLimiter {
+public:
+    // Frames have to fit under the budget less 1/2^releaseMarginShift of it
+    // before the cap starts going back up.
+    static constexpr uint8_t releaseMarginShift = 3;
+
+    // How long the cap takes to go back up from nothing to full (ms).
+    static constexpr uint16_t releaseTime = 2000;
+
+    static constexpr uint32_t channelMicroamps = MARQUEE_LED_CHANNEL_MICROAMPS;
+
+public:
+    // 0 means no limit.
+    void setBudget(uint16_t milliamps);
+
+    uint16_t getBudget() const {
+        return budget;
+    }
+
+    // Takes the next frame's load: the sum over its lit LED channels of PWM
+    // times scaling, each 0-255. globalCurrent is what the panels would be set
+    // to without the cap, and dt how long it's been since the last frame (ms).
+    void update(uint32_t load, uint8_t globalCurrent, uint32_t dt);
+
+    // The highest global current the panels can be set to.
+    uint8_t getMaxGlobalCurrent() const {
+        return cap >> 8;
+    }
+
+    // The last frame's load, as it was passed to update().
+    uint32_t getLoad() const {
+        return load;
+    }
+
+    // The LED current of the last frame, as it went out with the cap (mA).
+    uint16_t getEstimatedCurrent() const {
+        return estimate;
+    }
+
+    // Whether the cap held the last frame below the global current it asked for.
+    bool isLimiting() const {
+        return limiting;
+    }
+
+private:
+    static constexpr uint16_t maxCap = 255 << 8;
+
+    uint16_t budget = 0;
+
+    // In 256ths of a global current step, so the slow rise still moves every frame.
+    uint16_t cap = maxCap;
+    uint32_t load = 0;
+    uint16_t estimate = 0;
+    bool limiting = false;
+};
@@ -0,0 +1,85 @@
+#include "RenderScheduler.h"
+#include <esp_timer.h>
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+namespace {
+    const uint32_t tickMicros = portTICK_PERIOD_MS * 1000;
+}
+
+void RenderScheduler::begin(UBaseType_t priority) {
+    if (task != nullptr) {
+        return;
+    }
+
+    if (xTaskCreate(taskEntry, "render", taskStackSize, this, priority, &task) != pdPASS) {
+        LOGLN("Could not start render task");
+        task = nullptr;
+    }
+}
+
+uint32_t RenderScheduler::step(uint32_t now) {
+    if (started) {
+        if (int32_t(now - deadline) > int32_t(deadlineSlack)) {
+            metrics.missedDeadlines.increment();
+            LOGFMT("missed frame deadline by %d us\n\r", now - deadline);
+        }
+    } else {
+        lastUpdateTime = now;
+        started = true;
+    }
+
+    uint32_t dt = now - lastUpdateTime;
+    lastUpdateTime = now;
+
+    if (dt > 0) {
+        marquee.update(dt);
+    }
+
+    // Spare time before the next frame goes to getting the next playlist item
+    // ready, a slice per step so a frame is never held up for long.
+    if (marquee.timeUntilNextFrame() > tickMicros) {
+        marquee.prepareNextItem();
+    }
+
+    // Always sleep at least a tick, so a late frame can't starve lower priority tasks.
+    deadline = now + max(marquee.timeUntilNextFrame(), tickMicros);
+    return deadline;
+}
+
+void RenderScheduler::taskEntry(void* param) {
+    static_cast<RenderScheduler*>(param)->run();
+}
+
+void RenderScheduler::run() {
+    // A task delayed until a tick wakes right after that tick's interrupt, so
+    // the time it wakes at says where the tick boundaries fall.
+    vTaskDelay(1);
+    TickType_t wakeTick = xTaskGetTickCount();
+    uint32_t wakeTime = esp_timer_get_time();
+
+    while (true) {
+        // esp_timer's clock, the same one micros() reads on the ESP32.
+        const uint32_t due = step(esp_timer_get_time());
+        const int32_t untilDue = int32_t(due - wakeTime);
+
+        // Sleeping is in whole ticks, counted from the tick boundary the task
+        // woke at and rounded up, so a frame is never early. The marquee keeps
+        // its own frame times, so waking late doesn't push the following
+        // frames later, or hold the message back.
+        const TickType_t ticks = max((max(untilDue, int32_t(0)) + tickMicros - 1) / tickMicros, uint32_t(1));
+
+        if (int32_t(wakeTick + ticks - xTaskGetTickCount()) > 0) {
+            vTaskDelayUntil(&wakeTick, ticks);
+        } else {
+            // The frame ran past the tick it was due at. Sleep to the next
+            // boundary, which also keeps it from starving lower priority tasks.
+            vTaskDelay(1);
+            wakeTick = xTaskGetTickCount();
+        }
+
+        wakeTime = esp_timer_get_time();
+    }
+}
@@ -0,0 +1,55 @@
+#pragma once
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include "MarqueeController.h"
+#include "Metrics.h"
+
+// Drives MarqueeController::update() from its own task, sleeping until the
+// next frame is actually due instead of polling millis() in loop(). That
+// leaves the CPU to the web server between frames and keeps the frame
+// cadence exact.
+//
+// Time comes from the microsecond timer rather than the tick count, so the
+// message moves exactly with it, whatever the tick rate and however late the
+// task wakes. step() holds all of the timing logic and takes the current
+// time as a parameter, so it can be driven by a fake clock off-device.
+class RenderScheduler {
+public:
+    RenderScheduler(MarqueeController& marquee, Metrics& metrics) :
+        marquee(marquee),
+        metrics(metrics)
+    {
+
+    }
+
+    // Starts the render task.
+    void begin(UBaseType_t priority);
+
+    // Updates the marquee for the current time (in us) and returns the time the next frame is due.
+    uint32_t step(uint32_t now);
+
+    // Frames that started later than their deadline allows.
+    uint32_t getMissedDeadlines() const {
+        return metrics.missedDeadlines.get();
+    }
+
+private:
+    static void taskEntry(void* param);
+    void run();
+
+private:
+    static constexpr uint32_t taskStackSize = 4096;
+
+    // How late a frame can start before it counts as a missed deadline, in us.
+    static constexpr uint32_t deadlineSlack = 1000;
+
+    MarqueeController& marquee;
+    Metrics& metrics;
+    TaskHandle_t task = nullptr;
+
+    bool started = false;
+    uint32_t lastUpdateTime = 0;
+    uint32_t deadline = 0;
+};
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <Arduino.h>
+#include <atomic>
+
+// Bounded, lock-free queue for exactly one producer task and one consumer task.
+// The producer only ever writes tail and the consumer only ever writes head, so
+// each side just has to publish its index after it's done with the slot.
+template <typename T, uint16_t Capacity>
+class SPSCQueue {
+    static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+public:
+    // Producer side. Returns false if the queue is full.
+    bool push(const T& item) {
+        const uint32_t currentTail = tail.load(std::memory_order_relaxed);
+
+        if (currentTail - head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        items[currentTail & (Capacity - 1)] = item;
+        tail.store(currentTail + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer side. Returns false if the queue is empty.
+    bool pop(T& item) {
+        const uint32_t currentHead = head.load(std::memory_order_relaxed);
+
+        if (currentHead == tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = items[currentHead & (Capacity - 1)];
+        head.store(currentHead + 1, std::memory_order_release);
+        return true;
+    }
+
+private:
+    T items[Capacity];
+    std::atomic<uint32_t> head{0};
+    std::atomic<uint32_t> tail{0};
+};
@@ -1,15 +1,33 @@
 #include "Settings.h"
+#include <Adafruit_IS31FL3741.h>
 #include "Font.h"
 
+// The color order a new device starts with, until one is chosen on the web page.
+#if !defined(MARQUEE_COLOR_ORDER)
+    #define MARQUEE_COLOR_ORDER IS3741_BGR
+#endif
+
+// The white balance a new device starts with, until one is set through the
+// API. Red is heavily over-represented on this matrix when powered by 3.3
+// volts, so it's turned down.
+#if !defined(MARQUEE_WHITE_BALANCE)
+    #define MARQUEE_WHITE_BALANCE 0x94FFFF
+#endif
+
+// The LED current budget a new device starts with, in mA. Powered from a
+// 500 mA USB port, this leaves the rest for the ESP32 and its Wi-Fi.
+#if !defined(MARQUEE_POWER_BUDGET)
+    #define MARQUEE_POWER_BUDGET 300
+#endif
+
 namespace {
-    // A lot of these colors are biased away from red because red is
-    // heavily over-represented on this matrix when powered by 3.3 volts.    
+    // The white balance takes care of the matrix's bias, so these are true colors.
     const Settings::Color _colors[] = {
         {"Rainbow", "#000000"},
-        {"White", "#CFFFFF"},
+        {"White", "#FFFFFF"},
         {"Red", "#FF0000"},
-        {"Orange", "#E0A500"},
-        {"Yellow", "#CFFF00"},
+        {"Orange", "#FFA500"},
+        {"Yellow", "#FFFF00"},
         {"Green", "#00FF00"},
         {"Cyan", "#00FFFF"},
         {"Blue", "#0000FF"},
@@ -32,6 +50,27 @@ namespace {
         {"Very Fast", 20},
     };
 
+    // Value is whether smooth scrolling is enabled.
+    const Settings::UnsignedByte _scrollStyles[] = {
+        {"Stepped", 0},
+        {"Smooth", 1},
+    };
+
+    // Value is whether messages that fit on the display are held still in the middle of it.
+    const Settings::UnsignedByte _shortMessageModes[] = {
+        {"Scroll", 0},
+        {"Hold Centered", 1},
+    };
+
+    // Value is the gap between the end of the message and the next pass, in
+    // columns. 0 scrolls the message all the way off before it starts again.
+    const Settings::UnsignedByte _loopGaps[] = {
+        {"Off", 0},
+        {"Short", 6},
+        {"Medium", 12},
+        {"Long", 24},
+    };
+
     const Settings::UnsignedByte _brightnessValues[] = {
         {"Very Dim", 70},
         {"Dim", 126},
@@ -40,20 +79,55 @@ namespace {
         {"Very Bright", 255},
     };
 
+    // Value is whether brightness is set with the LED drivers' current
+    // rather than by dimming the pixel colors.
+    const Settings::UnsignedByte _brightnessModes[] = {
+        {"Pixel Colors", 0},
+        {"LED Current", 1},
+    };
+
     const Settings::UnsignedByte _displayRotations[] = {
         {"Down", 0},
         {"Left", 1},
         {"Up", 2},
         {"Right", 3},
     };
+
+    // Value is the IS3741_order of the matrix LEDs' color channels. It varies
+    // between batches of matrices, so it's picked to match the boot test pattern.
+    const Settings::UnsignedByte _colorOrders[] = {
+        {"RGB", IS3741_RGB},
+        {"RBG", IS3741_RBG},
+        {"GRB", IS3741_GRB},
+        {"GBR", IS3741_GBR},
+        {"BRG", IS3741_BRG},
+        {"BGR", IS3741_BGR},
+    };
+
+    uint8_t indexOfColorOrder(uint8_t order) {
+        for (uint8_t i = 0; i < sizeof(_colorOrders) / sizeof(_colorOrders[0]); i++) {
+            if (_colorOrders[i].value == order) {
+                return i;
+            }
+        }
+
+        return 0;
+    }
 }
 
 Settings::Settings() : 
     colors(_colors, sizeof(_colors) / sizeof(_colors[0]), 0),
     fonts(_fonts, sizeof(_fonts) / sizeof(_fonts[0]), 0),
     scrollDelays(_scrollDelays, sizeof(_scrollDelays) / sizeof(_scrollDelays[0]), 1),
+    scrollStyles(_scrollStyles, sizeof(_scrollStyles) / sizeof(_scrollStyles[0]), 0),
+    shortMessageModes(_shortMessageModes, sizeof(_shortMessageModes) / sizeof(_shortMessageModes[0]), 0),
+    loopGaps(_loopGaps, sizeof(_loopGaps) / sizeof(_loopGaps[0]), 0),
     brightnessValues(_brightnessValues, sizeof(_brightnessValues) / sizeof(_brightnessValues[0]), 2),
-    displayRotations(_displayRotations, sizeof(_displayRotations) / sizeof(_displayRotations[0]), 2) 
+    brightnessModes(_brightnessModes, sizeof(_brightnessModes) / sizeof(_brightnessModes[0]), 0),
+    displayRotations(_displayRotations, sizeof(_displayRotations) / sizeof(_displayRotations[0]), 2),
+    colorOrders(_colorOrders, sizeof(_colorOrders) / sizeof(_colorOrders[0]), indexOfColorOrder(MARQUEE_COLOR_ORDER)),
+    whiteBalance(uint32_t(MARQUEE_WHITE_BALANCE)),
+    powerBudget(MARQUEE_POWER_BUDGET)
 {
     
 }
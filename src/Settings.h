@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Arduino.h>
+#include "Color.h"
 
 // All of the marquee settings we're tracking here have the same structure,
 // which is essentially enumerated values with associated metadata.
@@ -30,9 +31,14 @@ public:
         return _index; 
     }
 
+    // Whether setIndex(index) would change the setting.
+    bool isChange(uint8_t index) const {
+        return index < _count && index != _index;
+    }
+
     // Returns true if index was actually set, false otherwise.
     bool setIndex(uint8_t index) {
-        if (index >= _count || index == _index) {
+        if (!isChange(index)) {
             return false;
         }
 
@@ -65,6 +71,19 @@ public:
     IndexedSetting<Color> colors;
     IndexedSetting<UnsignedByte> fonts;
     IndexedSetting<UnsignedByte> scrollDelays;
+    IndexedSetting<UnsignedByte> scrollStyles;
+    IndexedSetting<UnsignedByte> shortMessageModes;
+    IndexedSetting<UnsignedByte> loopGaps;
     IndexedSetting<UnsignedByte> brightnessValues;
+    IndexedSetting<UnsignedByte> brightnessModes;
     IndexedSetting<UnsignedByte> displayRotations;
+    IndexedSetting<UnsignedByte> colorOrders;
+
+    // Each color channel's LED current, 255 being full current, so the
+    // matrix's white comes out white and the colors above can be true ones.
+    ::Color::RGB whiteBalance;
+
+    // The LED current the display is dimmed to stay under, in mA, 0 for no
+    // limit. It depends on what the board is powered from.
+    uint16_t powerBudget;
 };
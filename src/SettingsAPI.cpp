@@ -0,0 +1,156 @@
+#include "SettingsAPI.h"
+#include <ArduinoJson.h>
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+namespace {
+    size_t write(const JsonDocument& json, Print& output) {
+        const size_t expectedSize = measureJson(json);
+        const size_t bytesSerialized = serializeJson(json, output);
+
+        LOGFMT("serialized json output size: %d\n\r", bytesSerialized);
+
+        // Print::write() reports short writes (e.g. out of memory) by returning less.
+        if (bytesSerialized != expectedSize) {
+            return 0;
+        }
+
+        return bytesSerialized;
+    }
+}
+
+SettingsAPI::SettingsDocument::SettingsDocument(const Settings& settings, MessageText* message) :
+    message((message != nullptr) ? message->retain() : nullptr)
+{
+    const struct {
+        const char* key;
+        unsigned value;
+    } values[] = {
+        {colorKey, settings.colors.currentIndex()},
+        {speedKey, settings.scrollDelays.currentIndex()},
+        {scrollStyleKey, settings.scrollStyles.currentIndex()},
+        {shortMessagesKey, settings.shortMessageModes.currentIndex()},
+        {loopGapKey, settings.loopGaps.currentIndex()},
+        {brightnessKey, settings.brightnessValues.currentIndex()},
+        {brightnessModeKey, settings.brightnessModes.currentIndex()},
+        {displayRotationKey, settings.displayRotations.currentIndex()},
+        {fontKey, settings.fonts.currentIndex()},
+        {colorOrderKey, settings.colorOrders.currentIndex()},
+        {powerBudgetKey, settings.powerBudget},
+    };
+
+    // Every key and value here is plain ASCII that needs no escaping. All of
+    // it fits in text with plenty to spare, but it's cut off there regardless.
+    size_t length = 0;
+
+    for (const auto& value : values) {
+        length = min(length + snprintf(text + length, textSize - length, "%c\"%s\":%u", (length == 0) ? '{' : ',', value.key, value.value), textSize - 1);
+    }
+
+    Color::RGB::HexStringBuffer whiteBalance;
+
+    if (settings.whiteBalance.toHexString(whiteBalance)) {
+        length = min(length + snprintf(text + length, textSize - length, ",\"%s\":\"%s\"", whiteBalanceKey, whiteBalance), textSize - 1);
+    }
+
+    length = min(length + snprintf(text + length, textSize - length, ",\"%s\":\"", messageKey), textSize - 1);
+    textLength = length;
+}
+
+SettingsAPI::SettingsDocument::SettingsDocument(const SettingsDocument& other) :
+    message((other.message != nullptr) ? other.message->retain() : nullptr),
+    messageOffset(other.messageOffset),
+    textLength(other.textLength),
+    textOffset(other.textOffset),
+    finished(other.finished)
+{
+    memcpy(text, other.text, textSize);
+}
+
+SettingsAPI::SettingsDocument::~SettingsDocument() {
+    if (message != nullptr) {
+        message->release();
+    }
+}
+
+size_t SettingsAPI::SettingsDocument::read(uint8_t* buffer, size_t size) {
+    size_t written = 0;
+
+    while (written < size) {
+        if (textOffset < textLength) {
+            const size_t count = min(size_t(textLength - textOffset), size - written);
+            memcpy(buffer + written, text + textOffset, count);
+            written += count;
+            textOffset += count;
+            continue;
+        }
+
+        const char* rest = (message != nullptr) ? message->c_str() + messageOffset : "";
+
+        // Runs of characters that don't need escaping are copied as they are.
+        size_t run = 0;
+
+        while (run < size - written && uint8_t(rest[run]) >= 0x20 && rest[run] != '"' && rest[run] != '\\') {
+            run++;
+        }
+
+        if (run > 0) {
+            memcpy(buffer + written, rest, run);
+            written += run;
+            messageOffset += run;
+            continue;
+        }
+
+        const char c = rest[0];
+
+        if (c == 0) {
+            if (finished) {
+                break;
+            }
+
+            textLength = snprintf(text, textSize, "\"}");
+            textOffset = 0;
+            finished = true;
+            continue;
+        }
+
+        messageOffset++;
+
+        // An escape goes out through text, so it can be split across buffers
+        // like anything else.
+        switch (c) {
+            case '"':   textLength = snprintf(text, textSize, "\\\""); break;
+            case '\\':  textLength = snprintf(text, textSize, "\\\\"); break;
+            case '\b':  textLength = snprintf(text, textSize, "\\b"); break;
+            case '\f':  textLength = snprintf(text, textSize, "\\f"); break;
+            case '\n':  textLength = snprintf(text, textSize, "\\n"); break;
+            case '\r':  textLength = snprintf(text, textSize, "\\r"); break;
+            case '\t':  textLength = snprintf(text, textSize, "\\t"); break;
+
+            default:    textLength = snprintf(text, textSize, "\\u%04x", uint8_t(c)); break;
+        }
+
+        textOffset = 0;
+    }
+
+    return written;
+}
+
+size_t SettingsAPI::serializePlaylist(const Playlist* playlist, Print& output) {
+    JsonDocument json;
+    JsonArray items = json[playlistItemsKey].to<JsonArray>();
+
+    for (uint8_t i = 0; playlist != nullptr && i < playlist->count(); i++) {
+        const Playlist::Item& item = playlist->item(i);
+        JsonObject itemJson = items.add<JsonObject>();
+
+        itemJson[messageKey] = item.message->c_str();
+        itemJson[fontKey] = item.fontIndex;
+        itemJson[colorKey] = item.colorIndex;
+        itemJson[repeatKey] = item.repeat;
+    }
+
+    return write(json, output);
+}
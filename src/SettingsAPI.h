@@ -0,0 +1,72 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Settings.h"
+#include "Playlist.h"
+#include "MessageText.h"
+
+// Names of the settings in the web API, shared by the HTML form and the JSON endpoint.
+namespace SettingsAPI {
+    const char* const messageKey = "message";
+    const char* const speedKey = "speed";
+    const char* const scrollStyleKey = "scrollStyle";
+    const char* const shortMessagesKey = "shortMessages";
+    const char* const loopGapKey = "loopGap";
+    const char* const brightnessKey = "brightness";
+    const char* const brightnessModeKey = "brightnessMode";
+    const char* const displayRotationKey = "rotation";
+    const char* const fontKey = "font";
+    const char* const colorKey = "textColor";
+    const char* const colorOrderKey = "colorOrder";
+    // "#RRGGBB", each channel's LED current. Not on the web page; it's set once per device.
+    const char* const whiteBalanceKey = "whiteBalance";
+    // In mA, 0 for no limit. Also not on the web page; it depends on the power supply.
+    const char* const powerBudgetKey = "powerBudget";
+
+    // The /playlist endpoint's items. Each one takes the message, font and
+    // color keys above, plus how many times it repeats.
+    const char* const playlistItemsKey = "items";
+    const char* const repeatKey = "repeat";
+
+    // Largest /settings or /playlist POST body accepted: a message of
+    // MarqueeController::maxMessageLength plain ASCII characters, with room
+    // for the other settings. Request bodies are held in memory whole, so
+    // this isn't stretched to allow for a maximum length message that's all
+    // escapes or multi-byte UTF-8.
+    static constexpr size_t maxRequestSize = 34 * 1024;
+
+    // The JSON document the /settings endpoint sends: the settings' current
+    // indexes, then the message. It's written a buffer at a time, for a
+    // chunked response, with the message escaped straight from its shared
+    // text, so a long message is never copied into a document or a response
+    // buffer. The settings are taken as they were when it was made.
+    class SettingsDocument {
+    public:
+        // Takes a reference to message of its own. nullptr is written as an empty message.
+        SettingsDocument(const Settings& settings, MessageText* message);
+        SettingsDocument(const SettingsDocument& other);
+        ~SettingsDocument();
+
+        SettingsDocument& operator=(const SettingsDocument&) = delete;
+
+        // Writes as much of the rest of the document as fits in buffer, and
+        // returns how much that was. Returns 0 once it's finished.
+        size_t read(uint8_t* buffer, size_t size);
+
+    private:
+        static constexpr size_t textSize = 256;
+
+        MessageText* message;
+        size_t messageOffset = 0;
+
+        // The settings, then each escape in the message, then the end of the document.
+        char text[textSize];
+        uint16_t textLength = 0;
+        uint16_t textOffset = 0;
+        bool finished = false;
+    };
+
+    // Writes the playlist as the document the /playlist endpoint sends, the
+    // same way. nullptr is written as an empty playlist.
+    size_t serializePlaylist(const Playlist* playlist, Print& output);
+}
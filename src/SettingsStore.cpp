@@ -0,0 +1,88 @@
+#include "SettingsStore.h"
+#include <Preferences.h>
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "Logger.h"
+
+namespace {
+    const char* const storeName = "marquee";
+
+    // Saved as the setting's value rather than its index, so reordering the
+    // choices in a later firmware doesn't change what's selected.
+    const char* const colorOrderKey = "colorOrder";
+
+    // Packed 0xRRGGBB.
+    const char* const whiteBalanceKey = "whiteBalance";
+
+    // In mA.
+    const char* const powerBudgetKey = "powerBudget";
+
+    template <typename T>
+    void select(IndexedSetting<T>& setting, uint8_t value) {
+        for (uint8_t i = 0; i < setting.count(); i++) {
+            if (setting.get(i).value == value) {
+                setting.setIndex(i);
+                return;
+            }
+        }
+
+        LOGFMT("Saved value %d doesn't match a setting, ignored\n\r", value);
+    }
+}
+
+void SettingsStore::load() {
+    Preferences preferences;
+
+    if (!preferences.begin(storeName, true)) {
+        // Nothing has been saved yet.
+        return;
+    }
+
+    if (preferences.isKey(colorOrderKey)) {
+        select(settings.colorOrders, preferences.getUChar(colorOrderKey));
+    }
+
+    if (preferences.isKey(whiteBalanceKey)) {
+        settings.whiteBalance = Color::RGB(preferences.getUInt(whiteBalanceKey));
+    }
+
+    if (preferences.isKey(powerBudgetKey)) {
+        settings.powerBudget = preferences.getUShort(powerBudgetKey);
+    }
+
+    preferences.end();
+}
+
+void SettingsStore::save() {
+    Preferences preferences;
+
+    if (!preferences.begin(storeName, false)) {
+        LOGLN("Couldn't open the settings store");
+        return;
+    }
+
+    const uint8_t colorOrder = settings.colorOrders.current().value;
+
+    if (!preferences.isKey(colorOrderKey) || preferences.getUChar(colorOrderKey) != colorOrder) {
+        if (preferences.putUChar(colorOrderKey, colorOrder) == 0) {
+            LOGLN("Couldn't save the color order");
+        }
+    }
+
+    const uint32_t whiteBalance = settings.whiteBalance.packed();
+
+    if (!preferences.isKey(whiteBalanceKey) || preferences.getUInt(whiteBalanceKey) != whiteBalance) {
+        if (preferences.putUInt(whiteBalanceKey, whiteBalance) == 0) {
+            LOGLN("Couldn't save the white balance");
+        }
+    }
+
+    if (!preferences.isKey(powerBudgetKey) || preferences.getUShort(powerBudgetKey) != settings.powerBudget) {
+        if (preferences.putUShort(powerBudgetKey, settings.powerBudget) == 0) {
+            LOGLN("Couldn't save the power budget");
+        }
+    }
+
+    preferences.end();
+}
@@ -0,0 +1,26 @@
+#pragma once
+
+#include <Arduino.h>
+#include "Settings.h"
+
+// Keeps the settings that describe the hardware, rather than what's being
+// shown, in flash (NVS) so they survive a restart: the color order of the
+// matrix LEDs, their white balance, and the power budget.
+class SettingsStore {
+public:
+    SettingsStore(Settings& _settings) :
+        settings(_settings)
+    {
+
+    }
+
+    // Replaces the defaults with the saved settings. Anything that was never
+    // saved, or no longer matches one of the setting's values, keeps its default.
+    void load();
+
+    // Saves the current values. Only writes to flash when something has changed.
+    void save();
+
+private:
+    Settings& settings;
+};
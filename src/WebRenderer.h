@@ -3,34 +3,74 @@
 #include <Arduino.h>
 #include "Settings.h"
 
-
+// Writes out the main page from its template and the current settings, a
+// buffer at a time, so it can be sent as a chunked response without the
+// whole page ever being held in RAM.
+//
+// The template is split ahead of time by tools/index_page.py into segments:
+// runs of text sent straight from flash, fields filled in from the settings,
+// and sections repeated for each item of a setting.
 class WebRenderer {
 public:
-    WebRenderer(Settings& _settings) :
-        settings(_settings)
-    {
+    enum class Field : uint8_t {
+        backgroundColor,
 
-    }
+        // These fill in the item of the section they're in.
+        index,
+        selected,
+        name,
+        color,  // colors only
+    };
 
-    void setDirty() {
-        dirty = true;
-    }
+    enum class Section : uint8_t {
+        colors,
+        brightnessValues,
+        brightnessModes,
+        scrollDelays,
+        scrollStyles,
+        shortMessageModes,
+        loopGaps,
+        fonts,
+        displayRotations,
+        colorOrders,
+    };
 
-    bool isDirty() const {
-        return dirty;
-    }
+    struct Segment {
+        enum Kind : uint8_t {
+            literal,
+            field,
+            sectionStart,
+            sectionEnd,
+        };
+
+        Kind kind;
+        uint8_t id;         // The Field or Section.
+        uint16_t length;    // Literals only.
+        const char* text;
+    };
 
-    void render();
+    // How far into the page a response has got.
+    struct Cursor {
+        uint16_t segment = 0;
+        uint16_t sectionStart = 0;
+        uint16_t offset = 0;    // Into the current segment's text.
+        uint8_t item = 0;       // Of the section it's in.
+    };
+
+public:
+    WebRenderer(Settings& _settings) :
+        settings(_settings)
+    {
 
-    const char* getRenderedDocument() const {
-        return renderedDocument;
     }
 
+    // Writes as much of the rest of the page as fits in buffer, and returns
+    // how much that was. Returns 0 once the page is finished.
+    size_t read(Cursor& cursor, uint8_t* buffer, size_t size) const;
+
 private:
-    static constexpr size_t renderedDocumentSize = 4 * 1024;
-    char renderedDocument[renderedDocumentSize] = {0};
+    uint8_t itemCount(Section section) const;
+    const char* fieldText(Field field, const Cursor& cursor, char* number) const;
 
     Settings& settings;
-
-    bool dirty = true;
-};
\ No newline at end of file
+};
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <Arduino.h>
+
+// The time source for benchmarks. On the device it's the CPU cycle counter,
+// which is cheap to read and exact; on the host it's the monotonic clock in
+// nanoseconds. Either way, a difference of two readings is the elapsed time.
+#if defined(ARDUINO)
+
+class BenchClock {
+public:
+    // 32 bits, so at 240 MHz a single measurement must be under about 17 seconds.
+    typedef uint32_t Ticks;
+
+    static constexpr bool countsCycles = true;
+
+    static const char* name() {
+        return "ccount";
+    }
+
+    static inline Ticks now() {
+        return ESP.getCycleCount();
+    }
+
+    static uint32_t ticksPerMicrosecond() {
+        return ESP.getCpuFreqMHz();
+    }
+};
+
+#else
+
+#include <chrono>
+
+class BenchClock {
+public:
+    typedef uint64_t Ticks;
+
+    static constexpr bool countsCycles = false;
+
+    static const char* name() {
+        return "steady_clock";
+    }
+
+    static inline Ticks now() {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count();
+    }
+
+    static uint32_t ticksPerMicrosecond() {
+        return 1000;
+    }
+};
+
+#endif
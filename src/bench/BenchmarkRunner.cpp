@@ -0,0 +1,63 @@
+#include "BenchmarkRunner.h"
+#include <algorithm>
+
+namespace {
+    template<typename T>
+    T median(T* sorted, uint8_t count) {
+        return (count % 2 == 1) ? sorted[count / 2] : (sorted[count / 2 - 1] + sorted[count / 2]) / 2;
+    }
+}
+
+void BenchmarkRunner::begin(const char* platform) {
+    benchmarkCount = 0;
+
+    out.printf("{\n  \"platform\": \"%s\",\n", platform);
+    out.printf("  \"clock\": \"%s\",\n", BenchClock::name());
+    out.printf("  \"ticks_per_us\": %u,\n", BenchClock::ticksPerMicrosecond());
+    out.printf("  \"compiler\": \"%s\",\n", __VERSION__);
+    out.printf("  \"build\": \"%s %s\",\n", __DATE__, __TIME__);
+    out.printf("  \"samples\": %u,\n", sampleCount);
+    out.printf("  \"benchmarks\": [");
+}
+
+void BenchmarkRunner::end() {
+    out.printf("\n  ]\n}\n");
+}
+
+void BenchmarkRunner::pause() {
+#if defined(ARDUINO)
+    delay(1);
+#endif
+}
+
+void BenchmarkRunner::report(const char* name, const char* variant, uint32_t iterations) {
+    std::sort(samples, samples + sampleCount);
+
+    const BenchClock::Ticks medianTicks = median(samples, sampleCount);
+
+    // Median absolute deviation, as a robust measure of the spread.
+    BenchClock::Ticks deviations[maxSamples];
+
+    for (uint8_t i = 0; i < sampleCount; i++) {
+        deviations[i] = (samples[i] > medianTicks) ? samples[i] - medianTicks : medianTicks - samples[i];
+    }
+
+    std::sort(deviations, deviations + sampleCount);
+
+    out.printf("%s\n    {\"name\": \"%s\", \"variant\": \"%s\", \"iterations\": %u", (benchmarkCount > 0) ? "," : "", name, variant, iterations);
+    writeNanoseconds("median_ns", medianTicks, iterations);
+    writeNanoseconds("min_ns", samples[0], iterations);
+    writeNanoseconds("max_ns", samples[sampleCount - 1], iterations);
+    writeNanoseconds("mad_ns", median(deviations, sampleCount), iterations);
+
+    if (BenchClock::countsCycles) {
+        out.printf(", \"median_cycles\": %.1f", double(medianTicks) / iterations);
+    }
+
+    out.printf("}");
+    benchmarkCount++;
+}
+
+void BenchmarkRunner::writeNanoseconds(const char* key, double ticks, uint32_t iterations) {
+    out.printf(", \"%s\": %.1f", key, ticks * 1000.0 / BenchClock::ticksPerMicrosecond() / iterations);
+}
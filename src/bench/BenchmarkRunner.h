@@ -0,0 +1,81 @@
+#pragma once
+
+#include <Arduino.h>
+#include "BenchClock.h"
+
+// Keeps the compiler from optimizing away a result that's otherwise unused.
+template<typename T>
+inline void benchKeep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+// Times small pieces of code and prints the results as one JSON document.
+//
+// Each benchmark body is run in a loop, with the iteration count doubled
+// until one loop takes at least the target sample time, so clock overhead
+// and timer resolution don't matter. That also warms up the caches. Then the
+// loop is timed sampleCount times and the per-call median, minimum, maximum
+// and median absolute deviation are reported. The median and MAD aren't
+// thrown off by the occasional interrupt or preemption the way a mean is.
+class BenchmarkRunner {
+public:
+    static constexpr uint8_t maxSamples = 31;
+
+public:
+    BenchmarkRunner(Print& out, uint8_t sampleCount, uint32_t targetSampleMicros) :
+        out(out),
+        sampleCount((sampleCount < maxSamples) ? sampleCount : maxSamples),
+        targetSampleTicks(BenchClock::Ticks(targetSampleMicros) * BenchClock::ticksPerMicrosecond())
+    {
+
+    }
+
+    // Prints the document header, with where and how the results were measured.
+    void begin(const char* platform);
+
+    template<typename Body>
+    void run(const char* name, const char* variant, Body body) {
+        uint32_t iterations = 1;
+
+        while (measure(body, iterations) < targetSampleTicks && iterations < maxIterations) {
+            iterations *= 2;
+        }
+
+        for (uint8_t i = 0; i < sampleCount; i++) {
+            pause();
+            samples[i] = measure(body, iterations);
+        }
+
+        report(name, variant, iterations);
+    }
+
+    // Closes the document.
+    void end();
+
+private:
+    template<typename Body>
+    static BenchClock::Ticks measure(Body& body, uint32_t iterations) {
+        const BenchClock::Ticks start = BenchClock::now();
+
+        for (uint32_t i = 0; i < iterations; i++) {
+            body();
+        }
+
+        return BenchClock::now() - start;
+    }
+
+    // Gives other tasks (and the watchdog) a chance to run between samples.
+    void pause();
+    void report(const char* name, const char* variant, uint32_t iterations);
+    void writeNanoseconds(const char* key, double ticks, uint32_t iterations);
+
+private:
+    static constexpr uint32_t maxIterations = 1UL << 24;
+
+    Print& out;
+    const uint8_t sampleCount;
+    const BenchClock::Ticks targetSampleTicks;
+
+    BenchClock::Ticks samples[maxSamples];
+    uint16_t benchmarkCount = 0;
+};
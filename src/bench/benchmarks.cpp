@@ -0,0 +1,493 @@
+// Benchmarks for the code that runs on every frame or every web request.
+// Built as its own program by the bench environments:
+//
+//     pio run -e bench_native && .pio/build/bench_native/program > bench.json
+//     pio run -e bench -t upload && pio device monitor
+//
+// Both print a JSON document (see BenchmarkRunner) so the results of two
+// firmware builds can be compared.
+
+#include <Arduino.h>
+#include <Adafruit_IS31FL3741.h>
+
+#include "../Settings.h"
+#include "../SettingsAPI.h"
+#include "../MarqueeController.h"
+#include "../DisplayFlusher.h"
+#include "../AsyncFlusher.h"
+#include "../DisplayPanel.h"
+#include "../PanelChain.h"
+#include "../Metrics.h"
+#include "../WebRenderer.h"
+#include "../Font.h"
+#include "../Color.h"
+#include "../transliterateUTF8.h"
+#include "../MessageText.h"
+#include "../Playlist.h"
+#include "BenchmarkRunner.h"
+
+namespace {
+    // Accepts everything, so frame benchmarks measure the CPU work but not the bus.
+    class NullBus : public I2CBus {
+    public:
+        bool write(uint8_t address, const uint8_t* data, size_t length) override {
+            return true;
+        }
+
+        size_t maxWriteSize() const override {
+            return 128;
+        }
+    };
+
+
+#if defined(ARDUINO)
+    const char* platform = "esp32";
+    const uint8_t sampleCount = 15;
+    const uint32_t targetSampleMicros = 2000;
+#else
+    const char* platform = "native";
+    const uint8_t sampleCount = 21;
+    const uint32_t targetSampleMicros = 5000;
+#endif
+
+    const uint32_t messageLengths[] = {16, 128, 511, MarqueeController::maxMessageLength};
+
+    // The longest a transliterated benchmark text gets.
+    const size_t transliterationBufferSize = 512;
+
+    // About what the web server asks for at a time: one TCP segment.
+    const size_t pageChunkSize = 1436;
+
+    const char* const fontNames[] = {"adafruit", "fixed", "fixedMono", "ancient"};
+
+    const char* const asciiText = "The quick brown fox jumps over the lazy dog. Pack my box with five dozen liquor jugs.";
+    const char* const latinText = "Ça va très bien! Über Straße, naïve café, señor, smørrebrød, Łódź, Ærøskøbing.";
+    const char* const cjkText = "日本語のテキスト表示、中文字符串测试、한국어 문장 시험입니다。";
+
+    const Color::RGB testColors[] = {
+        0xFF0000, 0x00FF00, 0x0000FF, 0xFFFFFF, 0xFFA500, 0xFFFF00, 0x00FFFF, 0x8000FF,
+        0xFF00FF, 0x123456, 0x654321, 0x808080, 0x010203, 0xFEDCBA, 0x3F7FBF, 0x000000,
+    };
+
+    const uint8_t testColorCount = sizeof(testColors) / sizeof(testColors[0]);
+
+    // A matrix and what sends frames to it, with nothing on the other end of the bus.
+    struct BenchPanel {
+        BenchPanel(I2CBus& bus, Metrics& metrics, IS3741_order order = IS3741_BGR) :
+            display(order),
+            flusher(bus, IS3741_ADDR_DEFAULT),
+            asyncFlusher(flusher, metrics),
+            panel(display, asyncFlusher)
+        {
+
+        }
+
+        Adafruit_IS31FL3741_QT_buffered display;
+        DisplayFlusher flusher;
+        AsyncFlusher asyncFlusher;
+        DisplayPanel panel;
+    };
+
+    // Fills buffer with length characters of repeated ASCII text.
+    void makeMessage(char* buffer, uint32_t length) {
+        const uint32_t textLength = strlen(asciiText);
+
+        for (uint32_t i = 0; i < length; i++) {
+            buffer[i] = asciiText[i % textLength];
+        }
+
+        buffer[length] = 0;
+    }
+
+    // The frame objects are big, so they're kept out of the stack.
+    Metrics metrics;
+    NullBus bus;
+    BenchPanel benchPanels[PanelChain::maxPanels] = {
+        {bus, metrics}, {bus, metrics}, {bus, metrics}, {bus, metrics},
+    };
+    DisplayPanel* const panelList[PanelChain::maxPanels] = {
+        &benchPanels[0].panel, &benchPanels[1].panel, &benchPanels[2].panel, &benchPanels[3].panel,
+    };
+    PanelChain panels(panelList, 1);
+    MarqueeController marquee(panels, metrics);
+    Settings settings;
+    WebRenderer webRenderer(settings);
+
+    char message[MarqueeController::maxMessageLength + 1];
+    char output[transliterationBufferSize];
+    uint8_t pageChunk[pageChunkSize];
+
+    void benchmarkMarqueeUpdate(BenchmarkRunner& runner) {
+        struct ColorMode {
+            const char* name;
+            Color::RGB color;
+        };
+
+        // Black selects the rainbow.
+        const ColorMode colorModes[] = {
+            {"solid", 0xFFFFFF},
+            {"rainbow", 0x000000},
+        };
+
+        for (const ColorMode& mode : colorModes) {
+            for (uint32_t length : messageLengths) {
+                char variant[32];
+                snprintf(variant, sizeof(variant), "%s/%u", mode.name, unsigned(length));
+
+                makeMessage(message, length);
+                marquee.setColor(mode.color);
+                marquee.setMessage(message);
+
+                // Every call composes and sends exactly one frame.
+                runner.run("marquee_update", variant, []() {
+                    marquee.update(marquee.timeUntilNextFrame());
+                });
+            }
+        }
+    }
+
+    void benchmarkRotations(BenchmarkRunner& runner) {
+        makeMessage(message, 128);
+        marquee.setColor(0xFFFFFF);
+        marquee.setMessage(message);
+
+        for (uint8_t rotation = 0; rotation < 4; rotation++) {
+            char variant[16];
+            snprintf(variant, sizeof(variant), "%u", rotation);
+
+            marquee.setRotation(rotation);
+
+            runner.run("marquee_rotation", variant, []() {
+                marquee.update(marquee.timeUntilNextFrame());
+            });
+        }
+
+        marquee.setRotation(0);
+    }
+
+    // The same message across 1 to maxPanels chained panels. The flushes are
+    // synchronous here, so this is the composing and the flushers' CPU work.
+    void benchmarkPanels(BenchmarkRunner& runner) {
+        makeMessage(message, 128);
+
+        for (uint8_t count = 1; count <= PanelChain::maxPanels; count++) {
+            char variant[16];
+            snprintf(variant, sizeof(variant), "%u", count);
+
+            // Too big for the stack, and only needed for this benchmark.
+            PanelChain* chain = new PanelChain(panelList, count);
+            MarqueeController* chained = new MarqueeController(*chain, metrics);
+            chained->setColor(0xFFFFFF);
+            chained->setMessage(message);
+
+            runner.run("marquee_panels", variant, [chained]() {
+                chained->update(chained->timeUntilNextFrame());
+            });
+
+            delete chained;
+            delete chain;
+        }
+    }
+
+    // Each color order, chosen the way the firmware used to, by building the
+    // driver with it, and the way it does now, at runtime on a driver built
+    // with another. The frames should take the same time.
+    void benchmarkColorOrders(BenchmarkRunner& runner) {
+        struct Order {
+            const char* name;
+            IS3741_order order;
+        };
+
+        const Order orders[] = {
+            {"RGB", IS3741_RGB}, {"RBG", IS3741_RBG}, {"GRB", IS3741_GRB},
+            {"GBR", IS3741_GBR}, {"BRG", IS3741_BRG}, {"BGR", IS3741_BGR},
+        };
+
+        makeMessage(message, 128);
+
+        for (const Order& order : orders) {
+            for (uint8_t runtime = 0; runtime < 2; runtime++) {
+                char variant[24];
+                snprintf(variant, sizeof(variant), "%s/%s", runtime ? "runtime" : "compiled", order.name);
+
+                // Too big for the stack, and only needed for this benchmark.
+                BenchPanel* benchPanel = new BenchPanel(bus, metrics, runtime ? IS3741_RGB : order.order);
+                DisplayPanel* const ordered[] = {&benchPanel->panel};
+                PanelChain* chain = new PanelChain(ordered, 1);
+                MarqueeController* orderedMarquee = new MarqueeController(*chain, metrics);
+
+                if (runtime) {
+                    orderedMarquee->setColorOrder(order.order);
+                }
+
+                orderedMarquee->setColor(0xFFFFFF);
+                orderedMarquee->setMessage(message);
+
+                runner.run("marquee_color_order", variant, [orderedMarquee]() {
+                    orderedMarquee->update(orderedMarquee->timeUntilNextFrame());
+                });
+
+                delete orderedMarquee;
+                delete chain;
+                delete benchPanel;
+            }
+        }
+    }
+
+    // A brightness change and then whatever the next update does, dimming the
+    // pixel colors and dimming with the LED current. The colors are redone at
+    // once, while the current starts a fade that later updates step.
+    void benchmarkBrightnessChanges(BenchmarkRunner& runner) {
+        const char* modes[] = {"pixels", "current"};
+
+        makeMessage(message, 128);
+        marquee.setColor(0xFFFFFF);
+        marquee.setMessage(message);
+
+        for (uint8_t hardware = 0; hardware < 2; hardware++) {
+            uint8_t i = 0;
+            marquee.setHardwareBrightness(hardware != 0);
+
+            runner.run("brightness_change", modes[hardware], [&i]() {
+                marquee.setBrightness((i++ & 1) ? 200 : 40);
+                marquee.update(marquee.timeUntilNextFrame());
+            });
+        }
+
+        marquee.setHardwareBrightness(false);
+        marquee.setBrightness(255);
+    }
+
+    // Frames of bright white text, with no power budget and with one it's
+    // always over, so every frame is limited. The current estimate is kept up
+    // a column at a time either way, so the two should take the same time.
+    void benchmarkPowerLimit(BenchmarkRunner& runner) {
+        const uint16_t budgets[] = {0, 50};
+
+        makeMessage(message, 128);
+        marquee.setColor(0xFFFFFF);
+        marquee.setMessage(message);
+
+        for (uint16_t budget : budgets) {
+            char variant[16];
+            snprintf(variant, sizeof(variant), "%u", budget);
+
+            marquee.setPowerBudget(budget);
+
+            runner.run("marquee_power_limit", variant, []() {
+                marquee.update(marquee.timeUntilNextFrame());
+            });
+        }
+
+        marquee.setPowerBudget(0);
+    }
+
+    // Frames of a message short enough to fit, scrolling and held in the
+    // middle. A held message's frames are all the same, so after the first
+    // one they're neither composed nor sent.
+    void benchmarkShortMessages(BenchmarkRunner& runner) {
+        makeMessage(message, 2);
+        marquee.setMessage(message);
+
+        for (bool center : {false, true}) {
+            marquee.setCenterShortMessages(center);
+
+            runner.run("marquee_short_message", center ? "held" : "scrolling", []() {
+                marquee.update(marquee.timeUntilNextFrame());
+            });
+        }
+
+        marquee.setCenterShortMessages(false);
+    }
+
+    // Frames of a message that loops with a gap and of one that scrolls off
+    // first. Looping only renumbers the columns once a pass, so the two
+    // should take the same time.
+    void benchmarkLooping(BenchmarkRunner& runner) {
+        const uint8_t gaps[] = {0, 12};
+
+        makeMessage(message, 16);
+        marquee.setMessage(message);
+
+        for (uint8_t gap : gaps) {
+            char variant[16];
+            snprintf(variant, sizeof(variant), "%u", gap);
+
+            marquee.setLoopGap(gap);
+
+            runner.run("marquee_loop", variant, []() {
+                marquee.update(marquee.timeUntilNextFrame());
+            });
+        }
+
+        marquee.setLoopGap(0);
+    }
+
+    // A short item and a maximum length one, alternating, each shown once. Every
+    // call is a frame and the spare-time slice that follows it, so the switches
+    // and the preparation for them are counted in with ordinary frames.
+    void benchmarkPlaylist(BenchmarkRunner& runner) {
+        Playlist* playlist = Playlist::create();
+        const uint32_t lengths[] = {16, MarqueeController::maxMessageLength};
+
+        for (uint32_t length : lengths) {
+            makeMessage(message, length);
+            MessageText* text = MessageText::copy(message, length);
+
+            Playlist::Item item;
+            item.message = text;
+            item.fontID = Font::ID::adafruit;
+            item.color = 0xFFFFFF;
+            item.repeat = 1;
+            item.fontIndex = 0;
+            item.colorIndex = 0;
+
+            playlist->add(item);
+            text->release();
+        }
+
+        marquee.setPlaylist(playlist);
+        playlist->release();
+
+        runner.run("marquee_playlist", "", []() {
+            marquee.update(marquee.timeUntilNextFrame());
+            marquee.prepareNextItem();
+        });
+
+        marquee.setPlaylist(nullptr);
+    }
+
+    void benchmarkTextWidth(BenchmarkRunner& runner) {
+        makeMessage(message, 128);
+
+        for (uint8_t id = 0; id < sizeof(fontNames) / sizeof(fontNames[0]); id++) {
+            const Font& font = Font::withID(Font::ID(id));
+
+            runner.run("font_text_width", fontNames[id], [&font]() {
+                benchKeep(font.textWidth(message));
+            });
+        }
+    }
+
+    void benchmarkColorConversions(BenchmarkRunner& runner) {
+        uint8_t i = 0;
+
+        runner.run("hsv_from_rgb", "", [&i]() {
+            benchKeep(Color::HSV::fromRGB(testColors[i++ % testColorCount]));
+        });
+
+        runner.run("hsv_to_rgb", "", [&i]() {
+            // Spread across the hues, saturations and values.
+            const Color::HSV hsv(i * 4099, 255 - (i & 63), 255 - (i & 31));
+            benchKeep(hsv.toRGB());
+            i++;
+        });
+
+        // The whole cost of a brightness change to the colors; nothing is converted per frame.
+        Color::LevelTable levels;
+
+        runner.run("level_table", "", [&i, &levels]() {
+            levels.setBrightness(i++);
+            benchKeep(levels.level(255));
+        });
+    }
+
+    void benchmarkTransliteration(BenchmarkRunner& runner) {
+        struct Input {
+            const char* name;
+            const char* text;
+        };
+
+        const Input inputs[] = {
+            {"ascii", asciiText},
+            {"latin", latinText},
+            {"cjk", cjkText},
+        };
+
+        for (const Input& input : inputs) {
+            const char* text = input.text;
+
+            runner.run("transliterate_utf8", input.name, [text]() {
+                transliterateUTF8(text, output, sizeof(output));
+                benchKeep(output);
+            });
+        }
+    }
+
+    void benchmarkWebRequests(BenchmarkRunner& runner) {
+        runner.run("web_render", "", []() {
+            WebRenderer::Cursor cursor;
+
+            while (webRenderer.read(cursor, pageChunk, sizeof(pageChunk)) > 0) {
+                benchKeep(pageChunk);
+            }
+        });
+
+        for (uint32_t length : {uint32_t(511), MarqueeController::maxMessageLength}) {
+            makeMessage(message, length);
+            MessageText* text = MessageText::copy(message, length);
+
+            if (text == nullptr) {
+                continue;
+            }
+
+            char variant[8];
+            snprintf(variant, sizeof(variant), "%u", unsigned(length));
+
+            // Streamed in the same chunks as the page, straight from the shared text.
+            runner.run("settings_serialize", variant, [text]() {
+                SettingsAPI::SettingsDocument document(settings, text);
+
+                while (document.read(pageChunk, sizeof(pageChunk)) > 0) {
+                    benchKeep(pageChunk);
+                }
+            });
+
+            text->release();
+        }
+    }
+
+    void runBenchmarks(Print& out) {
+        BenchmarkRunner runner(out, sampleCount, targetSampleMicros);
+
+        runner.begin(platform);
+        benchmarkMarqueeUpdate(runner);
+        benchmarkRotations(runner);
+        benchmarkPlaylist(runner);
+        benchmarkPanels(runner);
+        benchmarkColorOrders(runner);
+        benchmarkBrightnessChanges(runner);
+        benchmarkPowerLimit(runner);
+        benchmarkShortMessages(runner);
+        benchmarkLooping(runner);
+        benchmarkTextWidth(runner);
+        benchmarkColorConversions(runner);
+        benchmarkTransliteration(runner);
+        benchmarkWebRequests(runner);
+        runner.end();
+    }
+}
+
+#if defined(ARDUINO)
+
+void setup() {
+    Serial.begin(115200);
+
+    // Give the USB serial connection time to come up, so the start of the document isn't lost.
+    delay(3000);
+
+    runBenchmarks(Serial);
+}
+
+void loop() {
+    delay(1000);
+}
+
+#else
+
+int main() {
+    runBenchmarks(Serial);
+    return 0;
+}
+
+#endif
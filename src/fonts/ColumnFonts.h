@@ -0,0 +1,541 @@
+// Generated by tools/column_fonts.py from the GFXfont headers in this directory.
+// Don't edit by hand; change the fonts and run the script again.
+
+#pragma once
+
+#include "../ColumnFont.h"
+
+namespace ColumnFonts {
+    // The classic font's columns are filled in from the GFX library at runtime.
+    extern uint8_t classicColumns[475];
+
+    const ColumnFont::Glyph classicGlyphs[] PROGMEM = {
+        {   0,  0, 5},  // 0x20 ' '
+        {   5,  0, 5},  // 0x21 '!'
+        {  10,  0, 5},  // 0x22 '"'
+        {  15,  0, 5},  // 0x23 '#'
+        {  20,  0, 5},  // 0x24 '$'
+        {  25,  0, 5},  // 0x25 '%'
+        {  30,  0, 5},  // 0x26 '&'
+        {  35,  0, 5},  // 0x27 "'"
+        {  40,  0, 5},  // 0x28 '('
+        {  45,  0, 5},  // 0x29 ')'
+        {  50,  0, 5},  // 0x2A '*'
+        {  55,  0, 5},  // 0x2B '+'
+        {  60,  0, 5},  // 0x2C ','
+        {  65,  0, 5},  // 0x2D '-'
+        {  70,  0, 5},  // 0x2E '.'
+        {  75,  0, 5},  // 0x2F '/'
+        {  80,  0, 5},  // 0x30 '0'
+        {  85,  0, 5},  // 0x31 '1'
+        {  90,  0, 5},  // 0x32 '2'
+        {  95,  0, 5},  // 0x33 '3'
+        { 100,  0, 5},  // 0x34 '4'
+        { 105,  0, 5},  // 0x35 '5'
+        { 110,  0, 5},  // 0x36 '6'
+        { 115,  0, 5},  // 0x37 '7'
+        { 120,  0, 5},  // 0x38 '8'
+        { 125,  0, 5},  // 0x39 '9'
+        { 130,  0, 5},  // 0x3A ':'
+        { 135,  0, 5},  // 0x3B ';'
+        { 140,  0, 5},  // 0x3C '<'
+        { 145,  0, 5},  // 0x3D '='
+        { 150,  0, 5},  // 0x3E '>'
+        { 155,  0, 5},  // 0x3F '?'
+        { 160,  0, 5},  // 0x40 '@'
+        { 165,  0, 5},  // 0x41 'A'
+        { 170,  0, 5},  // 0x42 'B'
+        { 175,  0, 5},  // 0x43 'C'
+        { 180,  0, 5},  // 0x44 'D'
+        { 185,  0, 5},  // 0x45 'E'
+        { 190,  0, 5},  // 0x46 'F'
+        { 195,  0, 5},  // 0x47 'G'
+        { 200,  0, 5},  // 0x48 'H'
+        { 205,  0, 5},  // 0x49 'I'
+        { 210,  0, 5},  // 0x4A 'J'
+        { 215,  0, 5},  // 0x4B 'K'
+        { 220,  0, 5},  // 0x4C 'L'
+        { 225,  0, 5},  // 0x4D 'M'
+        { 230,  0, 5},  // 0x4E 'N'
+        { 235,  0, 5},  // 0x4F 'O'
+        { 240,  0, 5},  // 0x50 'P'
+        { 245,  0, 5},  // 0x51 'Q'
+        { 250,  0, 5},  // 0x52 'R'
+        { 255,  0, 5},  // 0x53 'S'
+        { 260,  0, 5},  // 0x54 'T'
+        { 265,  0, 5},  // 0x55 'U'
+        { 270,  0, 5},  // 0x56 'V'
+        { 275,  0, 5},  // 0x57 'W'
+        { 280,  0, 5},  // 0x58 'X'
+        { 285,  0, 5},  // 0x59 'Y'
+        { 290,  0, 5},  // 0x5A 'Z'
+        { 295,  0, 5},  // 0x5B '['
+        { 300,  0, 5},  // 0x5C '\\'
+        { 305,  0, 5},  // 0x5D ']'
+        { 310,  0, 5},  // 0x5E '^'
+        { 315,  0, 5},  // 0x5F '_'
+        { 320,  0, 5},  // 0x60 '`'
+        { 325,  0, 5},  // 0x61 'a'
+        { 330,  0, 5},  // 0x62 'b'
+        { 335,  0, 5},  // 0x63 'c'
+        { 340,  0, 5},  // 0x64 'd'
+        { 345,  0, 5},  // 0x65 'e'
+        { 350,  0, 5},  // 0x66 'f'
+        { 355,  0, 5},  // 0x67 'g'
+        { 360,  0, 5},  // 0x68 'h'
+        { 365,  0, 5},  // 0x69 'i'
+        { 370,  0, 5},  // 0x6A 'j'
+        { 375,  0, 5},  // 0x6B 'k'
+        { 380,  0, 5},  // 0x6C 'l'
+        { 385,  0, 5},  // 0x6D 'm'
+        { 390,  0, 5},  // 0x6E 'n'
+        { 395,  0, 5},  // 0x6F 'o'
+        { 400,  0, 5},  // 0x70 'p'
+        { 405,  0, 5},  // 0x71 'q'
+        { 410,  0, 5},  // 0x72 'r'
+        { 415,  0, 5},  // 0x73 's'
+        { 420,  0, 5},  // 0x74 't'
+        { 425,  0, 5},  // 0x75 'u'
+        { 430,  0, 5},  // 0x76 'v'
+        { 435,  0, 5},  // 0x77 'w'
+        { 440,  0, 5},  // 0x78 'x'
+        { 445,  0, 5},  // 0x79 'y'
+        { 450,  0, 5},  // 0x7A 'z'
+        { 455,  0, 5},  // 0x7B '{'
+        { 460,  0, 5},  // 0x7C '|'
+        { 465,  0, 5},  // 0x7D '}'
+        { 470,  0, 5},  // 0x7E '~'
+    };
+
+    const uint8_t classicAdvances[] PROGMEM = {
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    };
+
+    const ColumnFont classic PROGMEM = {classicColumns, classicGlyphs, classicAdvances, 0};
+
+    const uint8_t fixedColumns[] PROGMEM = {
+        0x5F, 0x03, 0x00, 0x03, 0x14, 0x7F, 0x14, 0x7F, 0x14, 0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13,
+        0x08, 0x64, 0x62, 0x36, 0x49, 0x55, 0x22, 0x50, 0x05, 0x03, 0x3E, 0x41, 0x41, 0x3E, 0x2A, 0x1C,
+        0x7F, 0x1C, 0x2A, 0x08, 0x08, 0x3E, 0x08, 0x08, 0x20, 0x60, 0x08, 0x08, 0x08, 0x08, 0x08, 0x60,
+        0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x51, 0x49, 0x45, 0x3E, 0x42, 0x7F, 0x40, 0x42, 0x61,
+        0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4B, 0x31, 0x18, 0x14, 0x12, 0x7F, 0x10, 0x2F, 0x49, 0x49,
+        0x49, 0x31, 0x3C, 0x4A, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05, 0x03, 0x36, 0x49, 0x49, 0x49,
+        0x36, 0x06, 0x49, 0x49, 0x29, 0x1E, 0x36, 0x36, 0x56, 0x36, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09, 0x06, 0x3E, 0x41, 0x5D, 0x59,
+        0x1E, 0x7C, 0x0A, 0x09, 0x0A, 0x7C, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22,
+        0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x3E,
+        0x41, 0x41, 0x49, 0x3A, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x41, 0x7F, 0x41, 0x20, 0x40, 0x41, 0x3F,
+        0x01, 0x7F, 0x08, 0x14, 0x22, 0x41, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x02, 0x04, 0x02, 0x7F,
+        0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x7F, 0x09, 0x09, 0x09, 0x06, 0x3E,
+        0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x46, 0x49, 0x49, 0x49, 0x31, 0x01, 0x01,
+        0x7F, 0x01, 0x01, 0x3F, 0x40, 0x40, 0x40, 0x3F, 0x1F, 0x20, 0x40, 0x20, 0x1F, 0x7F, 0x20, 0x10,
+        0x20, 0x7F, 0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04, 0x03, 0x61, 0x51, 0x49, 0x45,
+        0x43, 0x7F, 0x41, 0x41, 0x02, 0x04, 0x08, 0x10, 0x20, 0x41, 0x41, 0x7F, 0x04, 0x02, 0x01, 0x02,
+        0x04, 0x40, 0x40, 0x40, 0x40, 0x40, 0x01, 0x02, 0x04, 0x20, 0x54, 0x54, 0x78, 0x7F, 0x44, 0x44,
+        0x38, 0x38, 0x44, 0x44, 0x44, 0x38, 0x44, 0x44, 0x7F, 0x38, 0x54, 0x54, 0x58, 0x08, 0x7E, 0x09,
+        0x02, 0x48, 0x54, 0x54, 0x3C, 0x7F, 0x04, 0x04, 0x78, 0x7D, 0x20, 0x40, 0x40, 0x3D, 0x7F, 0x10,
+        0x28, 0x44, 0x7F, 0x7C, 0x04, 0x18, 0x04, 0x7C, 0x7C, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x38,
+        0x7C, 0x14, 0x14, 0x08, 0x08, 0x14, 0x14, 0x7C, 0x7C, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x24,
+        0x04, 0x3F, 0x44, 0x20, 0x3C, 0x40, 0x40, 0x3C, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x3C, 0x40, 0x30,
+        0x40, 0x3C, 0x44, 0x28, 0x10, 0x28, 0x44, 0x4C, 0x50, 0x50, 0x3C, 0x64, 0x54, 0x4C, 0x44, 0x08,
+        0x36, 0x41, 0x7F, 0x41, 0x36, 0x08, 0x18, 0x08, 0x10, 0x18,
+    };
+
+    const ColumnFont::Glyph fixedGlyphs[] PROGMEM = {
+        {   0,  0, 0},  // 0x20 ' '
+        {   0,  1, 1},  // 0x21 '!'
+        {   1,  0, 3},  // 0x22 '"'
+        {   4,  0, 5},  // 0x23 '#'
+        {   9,  0, 5},  // 0x24 '$'
+        {  14,  0, 5},  // 0x25 '%'
+        {  19,  0, 5},  // 0x26 '&'
+        {  24,  0, 2},  // 0x27 "'"
+        {  26,  0, 2},  // 0x28 '('
+        {  28,  0, 2},  // 0x29 ')'
+        {  30,  0, 5},  // 0x2A '*'
+        {  35,  0, 5},  // 0x2B '+'
+        {  40,  0, 2},  // 0x2C ','
+        {  42,  0, 5},  // 0x2D '-'
+        {  47,  0, 2},  // 0x2E '.'
+        {  49,  0, 5},  // 0x2F '/'
+        {  54,  0, 5},  // 0x30 '0'
+        {  59,  0, 3},  // 0x31 '1'
+        {  62,  0, 5},  // 0x32 '2'
+        {  67,  0, 5},  // 0x33 '3'
+        {  72,  0, 5},  // 0x34 '4'
+        {  77,  0, 5},  // 0x35 '5'
+        {  82,  0, 5},  // 0x36 '6'
+        {  87,  0, 5},  // 0x37 '7'
+        {  92,  0, 5},  // 0x38 '8'
+        {  97,  0, 5},  // 0x39 '9'
+        { 102,  0, 2},  // 0x3A ':'
+        { 104,  0, 2},  // 0x3B ';'
+        { 106,  0, 4},  // 0x3C '<'
+        { 110,  0, 5},  // 0x3D '='
+        { 115,  0, 4},  // 0x3E '>'
+        { 119,  0, 5},  // 0x3F '?'
+        { 124,  0, 5},  // 0x40 '@'
+        { 129,  0, 5},  // 0x41 'A'
+        { 134,  0, 5},  // 0x42 'B'
+        { 139,  0, 5},  // 0x43 'C'
+        { 144,  0, 5},  // 0x44 'D'
+        { 149,  0, 5},  // 0x45 'E'
+        { 154,  0, 5},  // 0x46 'F'
+        { 159,  0, 5},  // 0x47 'G'
+        { 164,  0, 5},  // 0x48 'H'
+        { 169,  1, 3},  // 0x49 'I'
+        { 172,  0, 5},  // 0x4A 'J'
+        { 177,  0, 5},  // 0x4B 'K'
+        { 182,  0, 5},  // 0x4C 'L'
+        { 187,  0, 5},  // 0x4D 'M'
+        { 192,  0, 5},  // 0x4E 'N'
+        { 197,  0, 5},  // 0x4F 'O'
+        { 202,  0, 5},  // 0x50 'P'
+        { 207,  0, 5},  // 0x51 'Q'
+        { 212,  0, 5},  // 0x52 'R'
+        { 217,  0, 5},  // 0x53 'S'
+        { 222,  0, 5},  // 0x54 'T'
+        { 227,  0, 5},  // 0x55 'U'
+        { 232,  0, 5},  // 0x56 'V'
+        { 237,  0, 5},  // 0x57 'W'
+        { 242,  0, 5},  // 0x58 'X'
+        { 247,  0, 5},  // 0x59 'Y'
+        { 252,  0, 5},  // 0x5A 'Z'
+        { 257,  0, 3},  // 0x5B '['
+        { 260,  0, 5},  // 0x5C '\\'
+        { 265,  0, 3},  // 0x5D ']'
+        { 268,  0, 5},  // 0x5E '^'
+        { 273,  0, 5},  // 0x5F '_'
+        { 278,  0, 3},  // 0x60 '`'
+        { 281,  0, 4},  // 0x61 'a'
+        { 285,  0, 4},  // 0x62 'b'
+        { 289,  0, 4},  // 0x63 'c'
+        { 293,  0, 4},  // 0x64 'd'
+        { 297,  0, 4},  // 0x65 'e'
+        { 301,  0, 4},  // 0x66 'f'
+        { 305,  0, 4},  // 0x67 'g'
+        { 309,  0, 4},  // 0x68 'h'
+        { 313,  0, 1},  // 0x69 'i'
+        { 314,  0, 4},  // 0x6A 'j'
+        { 318,  0, 4},  // 0x6B 'k'
+        { 322,  0, 1},  // 0x6C 'l'
+        { 323,  0, 5},  // 0x6D 'm'
+        { 328,  0, 4},  // 0x6E 'n'
+        { 332,  0, 4},  // 0x6F 'o'
+        { 336,  0, 4},  // 0x70 'p'
+        { 340,  0, 4},  // 0x71 'q'
+        { 344,  0, 4},  // 0x72 'r'
+        { 348,  0, 4},  // 0x73 's'
+        { 352,  0, 4},  // 0x74 't'
+        { 356,  0, 4},  // 0x75 'u'
+        { 360,  0, 5},  // 0x76 'v'
+        { 365,  0, 5},  // 0x77 'w'
+        { 370,  0, 5},  // 0x78 'x'
+        { 375,  0, 4},  // 0x79 'y'
+        { 379,  0, 4},  // 0x7A 'z'
+        { 383,  0, 3},  // 0x7B '{'
+        { 386,  0, 1},  // 0x7C '|'
+        { 387,  0, 3},  // 0x7D '}'
+        { 390,  0, 4},  // 0x7E '~'
+    };
+
+    const uint8_t fixedAdvances[] PROGMEM = {
+        3, 3, 4, 6, 6, 6, 6, 3, 3, 3, 6, 6, 3, 6, 3, 6,
+        6, 4, 6, 6, 6, 6, 6, 6, 6, 6, 3, 3, 5, 6, 5, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 4, 6, 4, 6, 6,
+        4, 5, 5, 5, 5, 5, 5, 5, 5, 2, 5, 5, 2, 6, 5, 5,
+        5, 5, 5, 5, 5, 5, 6, 6, 6, 5, 5, 4, 2, 4, 5,
+    };
+
+    const ColumnFont fixed PROGMEM = {fixedColumns, fixedGlyphs, fixedAdvances, -7};
+
+    const uint8_t fixedMonoColumns[] PROGMEM = {
+        0x5F, 0x03, 0x00, 0x03, 0x14, 0x7F, 0x14, 0x7F, 0x14, 0x24, 0x2A, 0x7F, 0x2A, 0x12, 0x23, 0x13,
+        0x08, 0x64, 0x62, 0x36, 0x49, 0x55, 0x22, 0x50, 0x05, 0x03, 0x3E, 0x41, 0x41, 0x3E, 0x2A, 0x1C,
+        0x7F, 0x1C, 0x2A, 0x08, 0x08, 0x3E, 0x08, 0x08, 0x20, 0x60, 0x08, 0x08, 0x08, 0x08, 0x08, 0x60,
+        0x60, 0x20, 0x10, 0x08, 0x04, 0x02, 0x3E, 0x51, 0x49, 0x45, 0x3E, 0x42, 0x7F, 0x40, 0x42, 0x61,
+        0x51, 0x49, 0x46, 0x21, 0x41, 0x45, 0x4B, 0x31, 0x18, 0x14, 0x12, 0x7F, 0x10, 0x2F, 0x49, 0x49,
+        0x49, 0x31, 0x3C, 0x4A, 0x49, 0x49, 0x30, 0x01, 0x71, 0x09, 0x05, 0x03, 0x36, 0x49, 0x49, 0x49,
+        0x36, 0x06, 0x49, 0x49, 0x29, 0x1E, 0x36, 0x36, 0x56, 0x36, 0x08, 0x14, 0x22, 0x41, 0x14, 0x14,
+        0x14, 0x14, 0x14, 0x41, 0x22, 0x14, 0x08, 0x02, 0x01, 0x51, 0x09, 0x06, 0x3E, 0x41, 0x5D, 0x59,
+        0x1E, 0x7C, 0x0A, 0x09, 0x0A, 0x7C, 0x7F, 0x49, 0x49, 0x49, 0x36, 0x3E, 0x41, 0x41, 0x41, 0x22,
+        0x7F, 0x41, 0x41, 0x22, 0x1C, 0x7F, 0x49, 0x49, 0x49, 0x41, 0x7F, 0x09, 0x09, 0x09, 0x01, 0x3E,
+        0x41, 0x41, 0x49, 0x3A, 0x7F, 0x08, 0x08, 0x08, 0x7F, 0x41, 0x7F, 0x41, 0x20, 0x40, 0x41, 0x3F,
+        0x01, 0x00, 0x7F, 0x08, 0x14, 0x22, 0x41, 0x7F, 0x40, 0x40, 0x40, 0x40, 0x7F, 0x02, 0x04, 0x02,
+        0x7F, 0x7F, 0x04, 0x08, 0x10, 0x7F, 0x3E, 0x41, 0x41, 0x41, 0x3E, 0x7F, 0x09, 0x09, 0x09, 0x06,
+        0x3E, 0x41, 0x51, 0x21, 0x5E, 0x7F, 0x09, 0x19, 0x29, 0x46, 0x46, 0x49, 0x49, 0x49, 0x31, 0x01,
+        0x01, 0x7F, 0x01, 0x01, 0x3F, 0x40, 0x40, 0x40, 0x3F, 0x1F, 0x20, 0x40, 0x20, 0x1F, 0x7F, 0x20,
+        0x10, 0x20, 0x7F, 0x63, 0x14, 0x08, 0x14, 0x63, 0x03, 0x04, 0x78, 0x04, 0x03, 0x61, 0x51, 0x49,
+        0x45, 0x43, 0x7F, 0x41, 0x41, 0x02, 0x04, 0x08, 0x10, 0x20, 0x41, 0x41, 0x7F, 0x04, 0x02, 0x01,
+        0x02, 0x04, 0x40, 0x40, 0x40, 0x40, 0x40, 0x01, 0x02, 0x04, 0x20, 0x54, 0x54, 0x54, 0x78, 0x7F,
+        0x44, 0x44, 0x44, 0x38, 0x38, 0x44, 0x44, 0x44, 0x44, 0x38, 0x44, 0x44, 0x44, 0x7F, 0x38, 0x54,
+        0x54, 0x54, 0x18, 0x08, 0x7E, 0x09, 0x02, 0x08, 0x54, 0x54, 0x54, 0x3C, 0x7F, 0x04, 0x04, 0x04,
+        0x78, 0x7D, 0x20, 0x40, 0x40, 0x3D, 0x7F, 0x10, 0x28, 0x44, 0x7F, 0x7C, 0x04, 0x18, 0x04, 0x7C,
+        0x7C, 0x08, 0x04, 0x04, 0x78, 0x38, 0x44, 0x44, 0x44, 0x38, 0x7C, 0x14, 0x14, 0x14, 0x08, 0x08,
+        0x14, 0x14, 0x14, 0x7C, 0x7C, 0x08, 0x04, 0x04, 0x08, 0x48, 0x54, 0x54, 0x54, 0x24, 0x04, 0x04,
+        0x3F, 0x44, 0x24, 0x3C, 0x40, 0x40, 0x40, 0x3C, 0x1C, 0x20, 0x40, 0x20, 0x1C, 0x3C, 0x40, 0x30,
+        0x40, 0x3C, 0x44, 0x28, 0x10, 0x28, 0x44, 0x0C, 0x50, 0x50, 0x50, 0x3C, 0x44, 0x64, 0x54, 0x4C,
+        0x44, 0x08, 0x36, 0x41, 0x7F, 0x45, 0x30, 0x09, 0x18, 0x08, 0x18, 0x10, 0x18,
+    };
+
+    const ColumnFont::Glyph fixedMonoGlyphs[] PROGMEM = {
+        {   0,  0, 0},  // 0x20 ' '
+        {   0,  2, 1},  // 0x21 '!'
+        {   1,  1, 3},  // 0x22 '"'
+        {   4,  0, 5},  // 0x23 '#'
+        {   9,  0, 5},  // 0x24 '$'
+        {  14,  0, 5},  // 0x25 '%'
+        {  19,  0, 5},  // 0x26 '&'
+        {  24,  1, 2},  // 0x27 "'"
+        {  26,  2, 2},  // 0x28 '('
+        {  28,  1, 2},  // 0x29 ')'
+        {  30,  0, 5},  // 0x2A '*'
+        {  35,  0, 5},  // 0x2B '+'
+        {  40,  1, 2},  // 0x2C ','
+        {  42,  0, 5},  // 0x2D '-'
+        {  47,  1, 2},  // 0x2E '.'
+        {  49,  0, 5},  // 0x2F '/'
+        {  54,  0, 5},  // 0x30 '0'
+        {  59,  1, 3},  // 0x31 '1'
+        {  62,  0, 5},  // 0x32 '2'
+        {  67,  0, 5},  // 0x33 '3'
+        {  72,  0, 5},  // 0x34 '4'
+        {  77,  0, 5},  // 0x35 '5'
+        {  82,  0, 5},  // 0x36 '6'
+        {  87,  0, 5},  // 0x37 '7'
+        {  92,  0, 5},  // 0x38 '8'
+        {  97,  0, 5},  // 0x39 '9'
+        { 102,  1, 2},  // 0x3A ':'
+        { 104,  1, 2},  // 0x3B ';'
+        { 106,  0, 4},  // 0x3C '<'
+        { 110,  0, 5},  // 0x3D '='
+        { 115,  1, 4},  // 0x3E '>'
+        { 119,  0, 5},  // 0x3F '?'
+        { 124,  0, 5},  // 0x40 '@'
+        { 129,  0, 5},  // 0x41 'A'
+        { 134,  0, 5},  // 0x42 'B'
+        { 139,  0, 5},  // 0x43 'C'
+        { 144,  0, 5},  // 0x44 'D'
+        { 149,  0, 5},  // 0x45 'E'
+        { 154,  0, 5},  // 0x46 'F'
+        { 159,  0, 5},  // 0x47 'G'
+        { 164,  0, 5},  // 0x48 'H'
+        { 169,  1, 3},  // 0x49 'I'
+        { 172,  0, 6},  // 0x4A 'J'
+        { 178,  0, 5},  // 0x4B 'K'
+        { 183,  0, 5},  // 0x4C 'L'
+        { 188,  0, 5},  // 0x4D 'M'
+        { 193,  0, 5},  // 0x4E 'N'
+        { 198,  0, 5},  // 0x4F 'O'
+        { 203,  0, 5},  // 0x50 'P'
+        { 208,  0, 5},  // 0x51 'Q'
+        { 213,  0, 5},  // 0x52 'R'
+        { 218,  0, 5},  // 0x53 'S'
+        { 223,  0, 5},  // 0x54 'T'
+        { 228,  0, 5},  // 0x55 'U'
+        { 233,  0, 5},  // 0x56 'V'
+        { 238,  0, 5},  // 0x57 'W'
+        { 243,  0, 5},  // 0x58 'X'
+        { 248,  0, 5},  // 0x59 'Y'
+        { 253,  0, 5},  // 0x5A 'Z'
+        { 258,  1, 3},  // 0x5B '['
+        { 261,  0, 5},  // 0x5C '\\'
+        { 266,  1, 3},  // 0x5D ']'
+        { 269,  0, 5},  // 0x5E '^'
+        { 274,  0, 5},  // 0x5F '_'
+        { 279,  1, 3},  // 0x60 '`'
+        { 282,  0, 5},  // 0x61 'a'
+        { 287,  0, 5},  // 0x62 'b'
+        { 292,  0, 5},  // 0x63 'c'
+        { 297,  0, 5},  // 0x64 'd'
+        { 302,  0, 5},  // 0x65 'e'
+        { 307,  0, 4},  // 0x66 'f'
+        { 311,  0, 5},  // 0x67 'g'
+        { 316,  0, 5},  // 0x68 'h'
+        { 321,  2, 1},  // 0x69 'i'
+        { 322,  0, 4},  // 0x6A 'j'
+        { 326,  0, 4},  // 0x6B 'k'
+        { 330,  2, 1},  // 0x6C 'l'
+        { 331,  0, 5},  // 0x6D 'm'
+        { 336,  0, 5},  // 0x6E 'n'
+        { 341,  0, 5},  // 0x6F 'o'
+        { 346,  0, 5},  // 0x70 'p'
+        { 351,  0, 5},  // 0x71 'q'
+        { 356,  0, 5},  // 0x72 'r'
+        { 361,  0, 5},  // 0x73 's'
+        { 366,  0, 5},  // 0x74 't'
+        { 371,  0, 5},  // 0x75 'u'
+        { 376,  0, 5},  // 0x76 'v'
+        { 381,  0, 5},  // 0x77 'w'
+        { 386,  0, 5},  // 0x78 'x'
+        { 391,  0, 5},  // 0x79 'y'
+        { 396,  0, 5},  // 0x7A 'z'
+        { 401,  1, 3},  // 0x7B '{'
+        { 404,  2, 1},  // 0x7C '|'
+        { 405,  1, 3},  // 0x7D '}'
+        { 408,  0, 5},  // 0x7E '~'
+    };
+
+    const uint8_t fixedMonoAdvances[] PROGMEM = {
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+        6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6, 6,
+    };
+
+    const ColumnFont fixedMono PROGMEM = {fixedMonoColumns, fixedMonoGlyphs, fixedMonoAdvances, -7};
+
+    const uint8_t ancientColumns[] PROGMEM = {
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xC3, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43,
+        0xC0, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43, 0xC3, 0x40, 0x00, 0x00, 0x00, 0x00, 0x00, 0x43,
+        0xC3, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xC3, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F,
+        0xCF, 0x43, 0x00, 0x00, 0x00, 0x00, 0x00, 0x4F, 0xCF, 0x4F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F,
+        0xCF, 0x4F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F, 0xFF, 0x4F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7F,
+        0xFF, 0x7F, 0x00, 0x00, 0x00, 0x00, 0x00, 0x24, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xCF, 0xFF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0xFF, 0xF3,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0xFF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0xCF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0x33, 0xFF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xF3, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xC3, 0xCF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCC, 0xFF, 0x33,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xF0, 0xCF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF0, 0x3F, 0xFC,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x3C, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x00, 0xC3,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x3F, 0xCC, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0xC3, 0xF3,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x0C, 0x3F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0x30, 0xF3,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xFF, 0xFF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x3C, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0xFF,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC3, 0x0F, 0x00, 0x00, 0x00, 0x00, 0x00, 0xF3, 0x3F, 0xC3,
+        0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x33, 0x33, 0xFF, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xC3, 0xCF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x03, 0xFF, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF3, 0xFF, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x30, 0xF3, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0x03, 0x03, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC0, 0xCF, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF3, 0x33, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xC3, 0xF3, 0xC3, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xCF, 0xC3, 0xCF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xFF, 0x00, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xCC, 0xFF, 0x33, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0xF0, 0xCF, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF0, 0x3F, 0xFC, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x3C, 0xF3, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0x00, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCC, 0x3F, 0xCC, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF3, 0xC3, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0x0C, 0x3F, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF3, 0x30, 0xF3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x03, 0xFF, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xC3, 0xFF, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xCF, 0x3C, 0xFF, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xFF, 0x30, 0xFF, 0x00, 0x00, 0x00, 0x00, 0x00, 0xFF, 0xC3, 0x0F, 0x00, 0x00,
+        0x00, 0x00, 0x00, 0xF3, 0x3F, 0xC3, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+    };
+
+    const ColumnFont::Glyph ancientGlyphs[] PROGMEM = {
+        {   0,  0, 1},  // 0x20 ' '
+        {   1,  0, 1},  // 0x21 '!'
+        {   2,  0, 1},  // 0x22 '"'
+        {   3,  0, 1},  // 0x23 '#'
+        {   4,  0, 1},  // 0x24 '$'
+        {   5,  0, 1},  // 0x25 '%'
+        {   6,  0, 1},  // 0x26 '&'
+        {   7,  0, 1},  // 0x27 "'"
+        {   8,  0, 1},  // 0x28 '('
+        {   9,  0, 1},  // 0x29 ')'
+        {  10,  0, 1},  // 0x2A '*'
+        {  11,  0, 1},  // 0x2B '+'
+        {  12,  0, 1},  // 0x2C ','
+        {  13,  0, 1},  // 0x2D '-'
+        {  14,  0, 8},  // 0x2E '.'
+        {  22,  0, 1},  // 0x2F '/'
+        {  23,  0, 8},  // 0x30 '0'
+        {  31,  0, 8},  // 0x31 '1'
+        {  39,  0, 8},  // 0x32 '2'
+        {  47,  0, 8},  // 0x33 '3'
+        {  55,  0, 8},  // 0x34 '4'
+        {  63,  0, 8},  // 0x35 '5'
+        {  71,  0, 8},  // 0x36 '6'
+        {  79,  0, 8},  // 0x37 '7'
+        {  87,  0, 8},  // 0x38 '8'
+        {  95,  0, 8},  // 0x39 '9'
+        { 103,  0, 8},  // 0x3A ':'
+        { 111,  0, 1},  // 0x3B ';'
+        { 112,  0, 1},  // 0x3C '<'
+        { 113,  0, 1},  // 0x3D '='
+        { 114,  0, 1},  // 0x3E '>'
+        { 115,  0, 1},  // 0x3F '?'
+        { 116,  0, 1},  // 0x40 '@'
+        { 117,  0, 8},  // 0x41 'A'
+        { 125,  0, 8},  // 0x42 'B'
+        { 133,  0, 8},  // 0x43 'C'
+        { 141,  0, 8},  // 0x44 'D'
+        { 149,  0, 8},  // 0x45 'E'
+        { 157,  0, 8},  // 0x46 'F'
+        { 165,  0, 8},  // 0x47 'G'
+        { 173,  0, 8},  // 0x48 'H'
+        { 181,  0, 8},  // 0x49 'I'
+        { 189,  0, 8},  // 0x4A 'J'
+        { 197,  0, 8},  // 0x4B 'K'
+        { 205,  0, 8},  // 0x4C 'L'
+        { 213,  0, 8},  // 0x4D 'M'
+        { 221,  0, 8},  // 0x4E 'N'
+        { 229,  0, 8},  // 0x4F 'O'
+        { 237,  0, 8},  // 0x50 'P'
+        { 245,  0, 8},  // 0x51 'Q'
+        { 253,  0, 8},  // 0x52 'R'
+        { 261,  0, 8},  // 0x53 'S'
+        { 269,  0, 8},  // 0x54 'T'
+        { 277,  0, 8},  // 0x55 'U'
+        { 285,  0, 8},  // 0x56 'V'
+        { 293,  0, 8},  // 0x57 'W'
+        { 301,  0, 8},  // 0x58 'X'
+        { 309,  0, 8},  // 0x59 'Y'
+        { 317,  0, 8},  // 0x5A 'Z'
+        { 325,  0, 1},  // 0x5B '['
+        { 326,  0, 1},  // 0x5C '\\'
+        { 327,  0, 1},  // 0x5D ']'
+        { 328,  0, 1},  // 0x5E '^'
+        { 329,  0, 1},  // 0x5F '_'
+        { 330,  0, 1},  // 0x60 '`'
+        { 331,  0, 8},  // 0x61 'a'
+        { 339,  0, 8},  // 0x62 'b'
+        { 347,  0, 8},  // 0x63 'c'
+        { 355,  0, 8},  // 0x64 'd'
+        { 363,  0, 8},  // 0x65 'e'
+        { 371,  0, 8},  // 0x66 'f'
+        { 379,  0, 8},  // 0x67 'g'
+        { 387,  0, 8},  // 0x68 'h'
+        { 395,  0, 8},  // 0x69 'i'
+        { 403,  0, 8},  // 0x6A 'j'
+        { 411,  0, 8},  // 0x6B 'k'
+        { 419,  0, 8},  // 0x6C 'l'
+        { 427,  0, 8},  // 0x6D 'm'
+        { 435,  0, 8},  // 0x6E 'n'
+        { 443,  0, 8},  // 0x6F 'o'
+        { 451,  0, 8},  // 0x70 'p'
+        { 459,  0, 8},  // 0x71 'q'
+        { 467,  0, 8},  // 0x72 'r'
+        { 475,  0, 8},  // 0x73 's'
+        { 483,  0, 8},  // 0x74 't'
+        { 491,  0, 8},  // 0x75 'u'
+        { 499,  0, 8},  // 0x76 'v'
+        { 507,  0, 8},  // 0x77 'w'
+        { 515,  0, 8},  // 0x78 'x'
+        { 523,  0, 8},  // 0x79 'y'
+        { 531,  0, 8},  // 0x7A 'z'
+        { 539,  0, 1},  // 0x7B '{'
+        { 540,  0, 1},  // 0x7C '|'
+        { 541,  0, 1},  // 0x7D '}'
+        { 542,  0, 1},  // 0x7E '~'
+    };
+
+    const uint8_t ancientAdvances[] PROGMEM = {
+        4, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 2, 0,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 2, 0, 0, 0, 0, 0,
+        0, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 0, 0, 0, 0, 0,
+        0, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 3, 4, 4, 4, 4,
+        4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 4, 0, 0, 0, 0,
+    };
+
+    const ColumnFont ancient PROGMEM = {ancientColumns, ancientGlyphs, ancientAdvances, -8};
+}
@@ -25,3 +25,18 @@ const char internal_error_html[] = R"rawliteral(
 </body>
 </html>
 )rawliteral";
+
+const char service_unavailable_html[] = R"rawliteral(
+<!DOCTYPE html>
+<html lang="en">
+<head>
+    <meta charset="UTF-8">
+    <meta name="viewport" content="width=device-width, initial-scale=1.0">
+    <title>503 Service Unavailable</title>
+</head>
+<body>
+    <h1>503 Service Unavailable</h1>
+    <p>The marquee is busy with earlier changes. Try again in a moment.</p>
+</body>
+</html>
+)rawliteral";
@@ -1,3 +1,6 @@
+// The main page's template. It isn't compiled in as it is: tools/index_page.py
+// splits it into the segments in index_page.h, which WebRenderer streams the
+// page from. Run the script again after changing it.
 const char index_html[] = R"rawliteral(
 <!DOCTYPE html>
 <html lang="en">
@@ -19,7 +22,7 @@ const char index_html[] = R"rawliteral(
         });
     </script>
 </head>
-<body style="background-color: {{BGCOLOR}};">
+<body style="background-color: {{backgroundColor}};">
     <div class="form-container">
         <form action="/update" method="post">
             <label for="message">Set message:</label>
@@ -27,50 +30,72 @@ const char index_html[] = R"rawliteral(
 
             <label for="textColor">Text Color:</label>
             <select id="textColor" name="textColor">
-                <option value="0"{{CS0}} data-color="{{C0}}">{{CN0}}</option>
-                <option value="1"{{CS1}} data-color="{{C1}}">{{CN1}}</option>
-                <option value="2"{{CS2}} data-color="{{C2}}">{{CN2}}</option>
-                <option value="3"{{CS3}} data-color="{{C3}}">{{CN3}}</option>
-                <option value="4"{{CS4}} data-color="{{C4}}">{{CN4}}</option>
-                <option value="5"{{CS5}} data-color="{{C5}}">{{CN5}}</option>
-                <option value="6"{{CS6}} data-color="{{C6}}">{{CN6}}</option>
-                <option value="7"{{CS7}} data-color="{{C7}}">{{CN7}}</option>
-                <option value="8"{{CS8}} data-color="{{C8}}">{{CN8}}</option>
-                <option value="9"{{CS9}} data-color="{{C9}}">{{CN9}}</option>
+{{#colors}}
+                <option value="{{index}}"{{selected}} data-color="{{color}}">{{name}}</option>
+{{/colors}}
             </select>
 
             <label for="brightness">Brightness:</label>
             <select id="brightness" name="brightness">
-                <option value="0"{{BS0}}>{{BN0}}</option>
-                <option value="1"{{BS1}}>{{BN1}}</option>
-                <option value="2"{{BS2}}>{{BN2}}</option>
-                <option value="3"{{BS3}}>{{BN3}}</option>
-                <option value="4"{{BS4}}>{{BN4}}</option>
+{{#brightnessValues}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/brightnessValues}}
             </select>            
 
+            <label for="brightnessMode">Dim With:</label>
+            <select id="brightnessMode" name="brightnessMode">
+{{#brightnessModes}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/brightnessModes}}
+            </select>
+
             <label for="speed">Speed:</label>
             <select id="speed" name="speed">
-                <option value="0"{{TS0}}>{{TN0}}</option>
-                <option value="1"{{TS1}}>{{TN1}}</option>
-                <option value="2"{{TS2}}>{{TN2}}</option>
-                <option value="3"{{TS3}}>{{TN3}}</option>
-                <option value="4"{{TS4}}>{{TN4}}</option>
+{{#scrollDelays}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/scrollDelays}}
+            </select>
+
+            <label for="scrollStyle">Scrolling:</label>
+            <select id="scrollStyle" name="scrollStyle">
+{{#scrollStyles}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/scrollStyles}}
+            </select>
+
+            <label for="shortMessages">Short Messages:</label>
+            <select id="shortMessages" name="shortMessages">
+{{#shortMessageModes}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/shortMessageModes}}
+            </select>
+
+            <label for="loopGap">Loop Gap:</label>
+            <select id="loopGap" name="loopGap">
+{{#loopGaps}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/loopGaps}}
             </select>
 
             <label for="font">Font:</label>
             <select id="font" name="font">
-                <option value="0"{{FS0}}>{{FN0}}</option> 
-                <option value="1"{{FS1}}>{{FN1}}</option> 
-                <option value="2"{{FS2}}>{{FN2}}</option>
-                <option value="3"{{FS3}}>{{FN3}}</option>
+{{#fonts}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/fonts}}
             </select>
 
             <label for="rotation">Rotation:</label>
             <select id="rotation" name="rotation">
-                <option value="0"{{RS0}}>{{RN0}}</option>
-                <option value="1"{{RS1}}>{{RN1}}</option>            
-                <option value="2"{{RS2}}>{{RN2}}</option>
-                <option value="3"{{RS3}}>{{RN3}}</option>
+{{#displayRotations}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/displayRotations}}
+            </select>
+
+            <label for="colorOrder">LED Color Order:</label>
+            <select id="colorOrder" name="colorOrder">
+{{#colorOrders}}
+                <option value="{{index}}"{{selected}}>{{name}}</option>
+{{/colorOrders}}
             </select>
             <br>            
             
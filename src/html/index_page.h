@@ -0,0 +1,233 @@
+// Generated by tools/index_page.py from the template in index_html.h.
+// Don't edit by hand; change the template and run the script again.
+
+#pragma once
+
+#include "../WebRenderer.h"
+
+namespace IndexPage {
+    const WebRenderer::Segment segments[] PROGMEM = {
+        {WebRenderer::Segment::literal, 0, 725,
+            "\n"
+            "<!DOCTYPE html>\n"
+            "<html lang=\"en\">\n"
+            "<head>\n"
+            "    <meta charset=\"UTF-8\">\n"
+            "    <meta name=\"viewport\" content=\"width=device-width, initial-scale=1.0\">\n"
+            "    <title>MiniMarquee</title>\n"
+            "    <link rel=\"stylesheet\" href=\"styles.css\">\n"
+            "    <script>\n"
+            "        document.addEventListener('DOMContentLoaded', () => {\n"
+            "            document.getElementById('textColor').addEventListener('change', function () {\n"
+            "                const selectedOption = this.options[this.selectedIndex];\n"
+            "                const color = selectedOption.getAttribute('data-color');\n"
+            "\n"
+            "                if (color) {\n"
+            "                    document.body.style.backgroundColor = color;\n"
+            "                }\n"
+            "            });\n"
+            "        });\n"
+            "    </script>\n"
+            "</head>\n"
+            "<body style=\"background-color: "},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::backgroundColor), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 306,
+            ";\">\n"
+            "    <div class=\"form-container\">\n"
+            "        <form action=\"/update\" method=\"post\">\n"
+            "            <label for=\"message\">Set message:</label>\n"
+            "            <input type=\"text\" id=\"message\" name=\"message\">\n"
+            "\n"
+            "            <label for=\"textColor\">Text Color:</label>\n"
+            "            <select id=\"textColor\" name=\"textColor\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::colors), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 13,
+            " data-color=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::color), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 2,
+            "\">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::colors), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 134,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"brightness\">Brightness:</label>\n"
+            "            <select id=\"brightness\" name=\"brightness\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::brightnessValues), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::brightnessValues), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 156,
+            "            </select>            \n"
+            "\n"
+            "            <label for=\"brightnessMode\">Dim With:</label>\n"
+            "            <select id=\"brightnessMode\" name=\"brightnessMode\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::brightnessModes), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::brightnessModes), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 114,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"speed\">Speed:</label>\n"
+            "            <select id=\"speed\" name=\"speed\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::scrollDelays), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::scrollDelays), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 136,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"scrollStyle\">Scrolling:</label>\n"
+            "            <select id=\"scrollStyle\" name=\"scrollStyle\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::scrollStyles), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::scrollStyles), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 147,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"shortMessages\">Short Messages:</label>\n"
+            "            <select id=\"shortMessages\" name=\"shortMessages\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::shortMessageModes), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::shortMessageModes), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 123,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"loopGap\">Loop Gap:</label>\n"
+            "            <select id=\"loopGap\" name=\"loopGap\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::loopGaps), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::loopGaps), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 110,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"font\">Font:</label>\n"
+            "            <select id=\"font\" name=\"font\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::fonts), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::fonts), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 126,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"rotation\">Rotation:</label>\n"
+            "            <select id=\"rotation\" name=\"rotation\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::displayRotations), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::displayRotations), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 139,
+            "            </select>\n"
+            "\n"
+            "            <label for=\"colorOrder\">LED Color Order:</label>\n"
+            "            <select id=\"colorOrder\" name=\"colorOrder\">\n"},
+        {WebRenderer::Segment::sectionStart, uint8_t(WebRenderer::Section::colorOrders), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 31,
+            "                <option value=\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::index), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            "\""},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::selected), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 1,
+            ">"},
+        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::name), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 10,
+            "</option>\n"},
+        {WebRenderer::Segment::sectionEnd, uint8_t(WebRenderer::Section::colorOrders), 0, nullptr},
+        {WebRenderer::Segment::literal, 0, 158,
+            "            </select>\n"
+            "            <br>            \n"
+            "            \n"
+            "            <button type=\"submit\">Update!</button>\n"
+            "        </form>\n"
+            "    </div>\n"
+            "</body>\n"
+            "</html>\n"},
+    };
+
+    const uint16_t segmentCount = sizeof(segments) / sizeof(segments[0]);
+}
@@ -2,28 +2,115 @@
 #include <Adafruit_IS31FL3741.h>
 
 #include "Settings.h"
+#include "SettingsStore.h"
 #include "MarqueeController.h"
 #include "MarqueeServer.h"
 #include "WebRenderer.h"
 #include "Font.h"
+#include "I2CBus.h"
+#include "DisplayFlusher.h"
+#include "AsyncFlusher.h"
+#include "DisplayPanel.h"
+#include "PanelChain.h"
+#include "PowerLimiter.h"
+#include "RenderScheduler.h"
+#include "Metrics.h"
 
 // Uncomment to print logs in this file to the serial console.
 //#define LOGGER Serial
 #include "Logger.h"
 
+//////////////////////////////
+// Panels
+//////////////////////////////
+// For more than one matrix, add -DMARQUEE_PANEL_COUNT=N (up to 4) to the build flags.
+#if !defined(MARQUEE_PANEL_COUNT)
+    #define MARQUEE_PANEL_COUNT 1
+#endif
+
+// Everything one LED matrix needs, from the I2C bus up.
+struct PanelHardware {
+    PanelHardware(TwoWire& wire, uint8_t address, Metrics& metrics) :
+        wire(wire),
+        address(address),
+        // The blitters write in the color order from the settings, so this is only where they start from.
+        display(IS3741_RGB),
+        bus(wire),
+        flusher(bus, address),
+        asyncFlusher(flusher, metrics),
+        panel(display, asyncFlusher)
+    {
+
+    }
+
+    TwoWire& wire;
+    const uint8_t address;
+    Adafruit_IS31FL3741_QT_buffered display;
+    WireBus bus;
+    DisplayFlusher flusher;
+    AsyncFlusher asyncFlusher;
+    DisplayPanel panel;
+};
+
 //////////////////////////////
 // Main object graph
 //////////////////////////////
-Adafruit_IS31FL3741_QT_buffered display(MARQUEE_COLOR_ORDER);
+Metrics metrics;
+
+// Left to right, as seen from the front. Panels alternate between the STEMMA QT
+// port (Wire1) and the SDA/SCL pads (Wire) so their frames are sent in parallel,
+// and the third and fourth need their ADDR jumper set to tell them apart.
+PanelHardware panelHardware[] = {
+    {Wire1, IS3741_ADDR_DEFAULT, metrics},
+#if MARQUEE_PANEL_COUNT > 1
+    {Wire, IS3741_ADDR_DEFAULT, metrics},
+#endif
+#if MARQUEE_PANEL_COUNT > 2
+    {Wire1, IS3741_ADDR_DEFAULT + 1, metrics},
+#endif
+#if MARQUEE_PANEL_COUNT > 3
+    {Wire, IS3741_ADDR_DEFAULT + 1, metrics},
+#endif
+};
+
+const uint8_t panelCount = sizeof(panelHardware) / sizeof(panelHardware[0]);
+static_assert(panelCount <= PanelChain::maxPanels, "Too many panels");
+
+DisplayPanel* const panelList[] = {
+    &panelHardware[0].panel,
+#if MARQUEE_PANEL_COUNT > 1
+    &panelHardware[1].panel,
+#endif
+#if MARQUEE_PANEL_COUNT > 2
+    &panelHardware[2].panel,
+#endif
+#if MARQUEE_PANEL_COUNT > 3
+    &panelHardware[3].panel,
+#endif
+};
+
+PanelChain panels(panelList, panelCount);
 Settings settings;
-MarqueeController marquee(display);
+SettingsStore settingsStore(settings);
+MarqueeController marquee(panels, metrics);
 WebRenderer webRenderer(settings);
-MarqueeServer marqueeServer(settings, marquee, webRenderer);
+MarqueeServer marqueeServer(settings, settingsStore, marquee, webRenderer, metrics);
+RenderScheduler renderScheduler(marquee, metrics);
+
+// How long the marquee takes to fade in once the test pattern is done, in ms.
+const uint16_t startupFadeTime = 1000;
 
 //////////////////////////////
-// Timing
+// Task priorities
 //////////////////////////////
-uint32_t lastUpdateTime = 0;
+#if !defined(MARQUEE_RENDER_TASK_PRIORITY)
+    #define MARQUEE_RENDER_TASK_PRIORITY 2
+#endif
+
+// Above the render task, so a submitted frame starts going out right away.
+// Every panel has a flush task at this priority.
+const UBaseType_t flushTaskPriority = MARQUEE_RENDER_TASK_PRIORITY + 1;
+const UBaseType_t renderTaskPriority = MARQUEE_RENDER_TASK_PRIORITY;
 
 //////////////////////////////
 // Forward reference
@@ -39,55 +126,88 @@ void setup() {
 
     initDisplay();
     marqueeServer.begin();
-    
-    lastUpdateTime = millis();
+
+    renderScheduler.begin(renderTaskPriority);
 }
 
 //////////////////////////////
 // Loop
 //////////////////////////////
 void loop() {
-    uint32_t now = millis();
-    uint32_t dt = now - lastUpdateTime;
-    lastUpdateTime = now;
-
-    if (dt > 0) {
-        marquee.update(dt);
-    }
+    // Frames are driven by the render task, so there's nothing left to do here.
+    vTaskDelete(NULL);
 }
 
 //////////////////////////////
 // Implementation
 //////////////////////////////
 void initDisplay() {
-    // Init I2C bus and speed it up as much as we can
+    // Init I2C buses and speed them up as much as we can
     Wire1.setPins(SDA1, SCL1);
     Wire1.setClock(1000000);
     Wire1.begin();
 
-    if( !display.begin(IS3741_ADDR_DEFAULT, &Wire1) ) {
-        LOGLN("LED matrix not found");
-        while(true);
+#if MARQUEE_PANEL_COUNT > 1
+    Wire.setClock(1000000);
+    Wire.begin();
+#endif
+
+    for (PanelHardware& hardware : panelHardware) {
+        if( !hardware.display.begin(hardware.address, &hardware.wire) ) {
+            LOGFMT("LED matrix not found at 0x%02x\n\r", hardware.address);
+            while(true);
+        }
+
+        // Set up matrix
+        hardware.display.setLEDscaling(255);
+        hardware.display.setGlobalCurrent(255);
+        hardware.display.enable(true);
     }
-    
-    // Set up matrix
-    display.setLEDscaling(255); 
-    display.setGlobalCurrent(255);
-    display.enable(true);
+
+    // The color order and white balance that were saved, if they were. The
+    // white balance is programmed into the LED scaling registers with the
+    // first frame; the test pattern shows the LEDs at full scale.
+    settingsStore.load();
+    marquee.setColorOrder(settings.colorOrders.current().value);
+    marquee.setWhiteBalance(settings.whiteBalance);
+    marquee.setPowerBudget(settings.powerBudget);
 
     // RGB test pattern to help verify the color order of the matrix LEDs is correct.
+    // If it isn't red, green then blue, choose the LED color order that makes it so.
     Color::RGB testPatternColors[] = {0xFF0000, 0x00FF00, 0x0000FF};
     const int testPatternColorsCount = sizeof(testPatternColors) / sizeof(testPatternColors[0]);
 
+    // Every color lights one whole channel of every panel, which can be more than the power budget allows.
+    PowerLimiter testPatternLimiter;
+    testPatternLimiter.setBudget(settings.powerBudget);
+    testPatternLimiter.update(panelCount * MatrixBlitter::ledCount * 255 * 255, DisplayFlusher::maxGlobalCurrent, 0);
+
     for (int i = 0; i < testPatternColorsCount; i++) {
-        display.fill(testPatternColors[i].packed565());
-        display.show();
+        for (PanelHardware& hardware : panelHardware) {
+            hardware.panel.blitter.fill(testPatternColors[i]);
+            hardware.flusher.flush(hardware.display.getBuffer(), testPatternLimiter.getMaxGlobalCurrent());
+        }
+
         delay(1000);
     }
     
     // Set default settings
     marquee.setRotation(settings.displayRotations.current().value);
     marquee.setScrollDelay(settings.scrollDelays.current().value);
+    marquee.setSmoothScrolling(settings.scrollStyles.current().value != 0);
+    marquee.setCenterShortMessages(settings.shortMessageModes.current().value != 0);
+    marquee.setLoopGap(settings.loopGaps.current().value);
     marquee.setFontID(Font::ID(settings.fonts.current().value));
     marquee.setBrightness(settings.brightnessValues.current().value);
+    marquee.setHardwareBrightness(settings.brightnessModes.current().value != 0);
+
+    // Fade steps resend the last frame, so the test pattern mustn't be it.
+    panels.clear();
+    marquee.fadeTo(0, 0);
+    marquee.fadeTo(255, startupFadeTime);
+
+    // From here on, frames are sent from the flush tasks.
+    for (PanelHardware& hardware : panelHardware) {
+        hardware.asyncFlusher.begin(flushTaskPriority);
+    }
 }
\ No newline at end of file
@@ -0,0 +1,55 @@
+#include "FrameDump.h"
+
+void SimFrame::read(const Adafruit_IS31FL3741_QT_buffered& display, const uint8_t* pwm, const uint8_t* scaling, int16_t x0, uint8_t globalCurrent) {
+    width = x0 + display.width();
+    height = display.height();
+
+    for (int16_t y = 0; y < height; y++) {
+        for (int16_t x = 0; x < display.width(); x++) {
+            uint8_t* pixel = rgb[y][x0 + x];
+            uint8_t scale[3];
+            display.getPixelRGB(pwm, x, y, pixel[0], pixel[1], pixel[2]);
+            display.getPixelRGB(scaling, x, y, scale[0], scale[1], scale[2]);
+
+            // LED current is proportional to all three.
+            for (uint8_t c = 0; c < 3; c++) {
+                pixel[c] = (uint32_t(pixel[c]) * scale[c] * globalCurrent + 255 * 255 / 2) / (255 * 255);
+            }
+        }
+    }
+}
+
+bool FrameDump::writePPM(const char* path, const SimFrame& frame, uint8_t scale) {
+    FILE* file = fopen(path, "wb");
+
+    if (file == nullptr) {
+        return false;
+    }
+
+    fprintf(file, "P6\n%d %d\n255\n", frame.width * scale, frame.height * scale);
+
+    for (int16_t y = 0; y < frame.height * scale; y++) {
+        for (int16_t x = 0; x < frame.width * scale; x++) {
+            fwrite(frame.rgb[y / scale][x / scale], 1, 3, file);
+        }
+    }
+
+    return fclose(file) == 0;
+}
+
+void FrameDump::writeANSI(FILE* out, const SimFrame& frame, bool redraw) {
+    if (redraw) {
+        fprintf(out, "\x1b[%dA", frame.height);
+    }
+
+    for (int16_t y = 0; y < frame.height; y++) {
+        for (int16_t x = 0; x < frame.width; x++) {
+            const uint8_t* pixel = frame.rgb[y][x];
+            fprintf(out, "\x1b[48;2;%d;%d;%dm  ", pixel[0], pixel[1], pixel[2]);
+        }
+
+        fprintf(out, "\x1b[0m\n");
+    }
+
+    fflush(out);
+}
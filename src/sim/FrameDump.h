@@ -0,0 +1,32 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_IS31FL3741.h>
+#include "../PanelChain.h"
+
+// One displayed frame across all the panels, in the matrices' rotated
+// coordinates, so it reads the way the viewer sees it. Values are each LED's
+// PWM duty scaled by its scaling register and the panel's global current, so
+// they show the white balance, and follow fades and hardware brightness too.
+struct SimFrame {
+    static constexpr uint8_t maxSide = 13;
+    static constexpr uint8_t maxWidth = maxSide * PanelChain::maxPanels;
+
+    int16_t width = 0;
+    int16_t height = 0;
+    uint8_t rgb[maxSide][maxWidth][3];
+
+    // Reads one panel's frame out of PWM and scaling registers laid out like
+    // the display's buffer, into the columns from x on. The frame ends at that
+    // panel's right edge.
+    void read(const Adafruit_IS31FL3741_QT_buffered& display, const uint8_t* pwm, const uint8_t* scaling, int16_t x, uint8_t globalCurrent);
+};
+
+namespace FrameDump {
+    // Binary PPM, with each LED drawn as a scale x scale block.
+    bool writePPM(const char* path, const SimFrame& frame, uint8_t scale);
+
+    // 24-bit color terminal art, two characters per LED. If redraw is true,
+    // the cursor is first moved back up over the previous frame so it animates in place.
+    void writeANSI(FILE* out, const SimFrame& frame, bool redraw);
+}
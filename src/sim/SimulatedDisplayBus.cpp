@@ -0,0 +1,74 @@
+#include "SimulatedDisplayBus.h"
+
+// Uncomment to print logs in this file to the serial console.
+//#define LOGGER Serial
+#include "../Logger.h"
+
+namespace {
+    const uint8_t commandRegister = 0xFD;
+    const uint8_t commandRegisterLock = 0xFE;
+    const uint8_t commandRegisterUnlock = 0xC5;
+
+    const uint16_t page0PWMCount = 180;
+    const uint16_t page1PWMCount = 171;
+}
+
+bool SimulatedDisplayBus::write(uint8_t deviceAddress, const uint8_t* data, size_t length) {
+    stats.bytes += length + 1;
+    stats.transactions++;
+
+    if (logCount < logSize) {
+        log[logCount++] = {deviceAddress, (length > 0) ? data[0] : uint8_t(0), uint16_t((length > 0) ? length - 1 : 0), selectedPage};
+    }
+
+    if (deviceAddress != address) {
+        // Nothing would acknowledge it.
+        return false;
+    }
+
+    if (length == 0 || length > maxWrite) {
+        LOGFMT("bad write length: %d\n\r", length);
+        stats.protocolErrors++;
+        return false;
+    }
+
+    const uint8_t reg = data[0];
+
+    if (reg == commandRegisterLock && length == 2) {
+        unlocked = data[1] == commandRegisterUnlock;
+        return true;
+    }
+
+    if (reg == commandRegister && length == 2) {
+        // The chip ignores page changes unless they're unlocked first, and relocks after each one.
+        if (!unlocked || data[1] >= pageCount) {
+            LOGFMT("page %d select ignored\n\r", data[1]);
+            stats.protocolErrors++;
+        } else {
+            selectedPage = data[1];
+        }
+
+        unlocked = false;
+        return true;
+    }
+
+    // Register writes auto-increment within the selected page.
+    if (reg + (length - 1) > pageSize) {
+        LOGFMT("write past end of page %d\n\r", selectedPage);
+        stats.protocolErrors++;
+        return false;
+    }
+
+    memcpy(&registers[selectedPage][reg], data + 1, length - 1);
+    return true;
+}
+
+void SimulatedDisplayBus::readPWM(uint8_t* frame) const {
+    memcpy(frame, registers[0], page0PWMCount);
+    memcpy(frame + page0PWMCount, registers[1], page1PWMCount);
+}
+
+void SimulatedDisplayBus::readScaling(uint8_t* scaling) const {
+    memcpy(scaling, registers[2], page0PWMCount);
+    memcpy(scaling + page0PWMCount, registers[3], page1PWMCount);
+}
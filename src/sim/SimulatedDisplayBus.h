@@ -0,0 +1,95 @@
+#pragma once
+
+#include <Arduino.h>
+#include "../I2CBus.h"
+
+// An I2CBus with a model of the IS31FL3741's register pages behind it, so the
+// simulator shows what the chip would be displaying after the flusher's partial
+// updates, rather than what was composed. Also checks that page changes are
+// unlocked first, the way the chip requires, and keeps a log of the writes
+// so tests can check what went out.
+class SimulatedDisplayBus : public I2CBus {
+public:
+    static constexpr uint8_t pageCount = 5;
+    static constexpr uint16_t pageSize = 256;
+
+    struct Stats {
+        uint32_t bytes = 0;
+        uint32_t transactions = 0;
+        // Writes the real chip would have ignored or misapplied.
+        uint32_t protocolErrors = 0;
+    };
+
+    // One write, as the chip saw it.
+    struct Transaction {
+        uint8_t address;
+        // The register written first, which for page changes is the command register.
+        uint8_t reg;
+        // Data bytes after the register address.
+        uint16_t length;
+        // The page selected when the write arrived.
+        int8_t page;
+    };
+
+    // The writes since clearLog() are kept, up to this many.
+    static constexpr uint16_t logSize = 64;
+
+public:
+    SimulatedDisplayBus(uint8_t address, size_t maxWrite = 128) :
+        address(address),
+        maxWrite(maxWrite)
+    {
+
+    }
+
+    bool write(uint8_t address, const uint8_t* data, size_t length) override;
+
+    size_t maxWriteSize() const override {
+        return maxWrite;
+    }
+
+    // Copies the 351 PWM registers, which span pages 0 and 1, into frame.
+    void readPWM(uint8_t* frame) const;
+
+    // Copies the 351 LED scaling registers, which span pages 2 and 3, into scaling.
+    void readScaling(uint8_t* scaling) const;
+
+    // The global current control register, in the configuration page.
+    uint8_t globalCurrent() const {
+        return registers[4][1];
+    }
+
+    const uint8_t* page(uint8_t p) const {
+        return registers[p];
+    }
+
+    const Stats& getStats() const {
+        return stats;
+    }
+
+    // The writes since the last clearLog(), including ones to other addresses.
+    const Transaction& transaction(uint16_t index) const {
+        return log[index];
+    }
+
+    uint16_t transactionCount() const {
+        return logCount;
+    }
+
+    void clearLog() {
+        logCount = 0;
+    }
+
+private:
+    const uint8_t address;
+    const size_t maxWrite;
+
+    uint8_t registers[pageCount][pageSize] = {{0}};
+    int8_t selectedPage = 0;
+    bool unlocked = false;
+
+    Stats stats;
+
+    Transaction log[logSize];
+    uint16_t logCount = 0;
+};
@@ -0,0 +1,30 @@
+#pragma once
+
+#include <Arduino.h>
+#include <Adafruit_IS31FL3741.h>
+#include "../DisplayFlusher.h"
+#include "../AsyncFlusher.h"
+#include "../DisplayPanel.h"
+#include "../Metrics.h"
+#include "SimulatedDisplayBus.h"
+
+// Everything one simulated matrix needs, from the bus up, for the simulator
+// and the native tests. Its flusher isn't started, so frames are flushed
+// synchronously as they're submitted unless asyncFlusher.begin() is called.
+struct SimulatedPanel {
+    SimulatedPanel(Metrics& metrics, uint8_t address = IS3741_ADDR_DEFAULT) :
+        display(MARQUEE_COLOR_ORDER),
+        bus(address),
+        flusher(bus, address),
+        asyncFlusher(flusher, metrics),
+        panel(display, asyncFlusher)
+    {
+
+    }
+
+    Adafruit_IS31FL3741_QT_buffered display;
+    SimulatedDisplayBus bus;
+    DisplayFlusher flusher;
+    AsyncFlusher asyncFlusher;
+    DisplayPanel panel;
+};
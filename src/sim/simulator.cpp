@@ -0,0 +1,433 @@
+// Host-side marquee simulator, built by the native environment:
+//
+//     pio run -e native
+//     .pio/build/native/program --ansi "Hello world"
+//
+// Runs the same MarqueeController, DisplayFlusher and fonts as the firmware
+// against a simulated matrix, on simulated time, and shows the frames the
+// display would end up with. Settings are chosen by index, the same as the
+// web page's menus. More than one message makes a playlist, each item shown
+// once in the chosen font and color. With --panels, several matrices are
+// chained side by side, each on its own simulated bus.
+//
+// The simulated matrices' LEDs are in MARQUEE_COLOR_ORDER, which is also the
+// default --color-order setting. Choosing another shows what the marquee
+// looks like with the wrong one selected. --white-balance takes the same
+// "#RRGGBB" as the web API.
+//
+// --late makes each update up to that many ms late, as if the render task
+// were kept waiting. Frames that come due meanwhile are skipped, but the
+// message should still be wherever the time puts it, and the passes should
+// take as long as they do without it.
+
+#include <Arduino.h>
+#include <Adafruit_IS31FL3741.h>
+#include <getopt.h>
+#include <sys/stat.h>
+
+#include "../Settings.h"
+#include "../MarqueeController.h"
+#include "../DisplayFlusher.h"
+#include "../PanelChain.h"
+#include "../Metrics.h"
+#include "../MessageText.h"
+#include "../Playlist.h"
+#include "SimulatedDisplayBus.h"
+#include "SimulatedPanel.h"
+#include "FrameDump.h"
+
+// The native tests have mains of their own, and share the rest of src with the simulator.
+#ifndef PIO_UNIT_TESTING
+
+namespace {
+    struct Options {
+        const char* message = "Hello from the simulator!";
+        char** playlist = nullptr;
+        int playlistLength = 0;
+        uint32_t frames = 200;
+        uint8_t color = 0;
+        uint8_t font = 0;
+        uint8_t speed = 1;
+        uint8_t style = 0;
+        uint8_t shortMessages = 0;
+        uint8_t loopGap = 0;
+        uint8_t brightness = 2;
+        uint8_t brightnessMode = 0;
+        uint16_t fadeIn = 0;
+        uint16_t late = 0;
+        uint8_t rotation = 2;
+        uint8_t colorOrder = 0;
+        const char* whiteBalance = nullptr;
+        int32_t powerBudget = -1;
+        uint8_t panels = 1;
+        const char* ppmDirectory = nullptr;
+        uint8_t ppmScale = 8;
+        bool ansi = false;
+        bool quiet = false;
+    };
+
+    void printSetting(const char* name, const IndexedSetting<Settings::UnsignedByte>& setting) {
+        fprintf(stderr, "  %-14s", name);
+
+        for (uint8_t i = 0; i < setting.count(); i++) {
+            fprintf(stderr, " %d=%s", i, setting.get(i).name);
+        }
+
+        fprintf(stderr, " (default %d)\n", setting.currentIndex());
+    }
+
+    void printUsage(const char* program, const Settings& settings) {
+        fprintf(stderr, "Usage: %s [options] [message...]\n\n", program);
+        fprintf(stderr, "  -n, --frames N      frames to render (default 200)\n");
+        fprintf(stderr, "  -p, --ppm DIR       write each frame to DIR/frame-NNNNN.ppm\n");
+        fprintf(stderr, "  -s, --scale N       size of each LED in the PPM files (default 8)\n");
+        fprintf(stderr, "  -a, --ansi          draw frames in the terminal, at the real frame rate\n");
+        fprintf(stderr, "      --panels N      chain N matrices side by side (1-%d, default 1)\n", PanelChain::maxPanels);
+        fprintf(stderr, "      --fade-in MS    fade in from black at the start, like the firmware does\n");
+        fprintf(stderr, "      --late MS       make each update up to MS late, like a busy render task\n");
+        fprintf(stderr, "  -q, --quiet         don't print the summary\n\n");
+        fprintf(stderr, "Settings, by index:\n");
+
+        fprintf(stderr, "  %-14s", "--color");
+
+        for (uint8_t i = 0; i < settings.colors.count(); i++) {
+            fprintf(stderr, " %d=%s", i, settings.colors.get(i).name);
+        }
+
+        fprintf(stderr, " (default %d)\n", settings.colors.currentIndex());
+
+        printSetting("--font", settings.fonts);
+        printSetting("--speed", settings.scrollDelays);
+        printSetting("--style", settings.scrollStyles);
+        printSetting("--short", settings.shortMessageModes);
+        printSetting("--loop-gap", settings.loopGaps);
+        printSetting("--brightness", settings.brightnessValues);
+        printSetting("--dim-with", settings.brightnessModes);
+        printSetting("--rotation", settings.displayRotations);
+        printSetting("--color-order", settings.colorOrders);
+
+        Color::RGB::HexStringBuffer whiteBalance;
+        settings.whiteBalance.toHexString(whiteBalance);
+        fprintf(stderr, "  %-14s #RRGGBB, each channel's LED current (default %s)\n", "--white-balance", whiteBalance);
+        fprintf(stderr, "  %-14s mA, 0 for no limit (default %u)\n", "--power-budget", settings.powerBudget);
+    }
+
+    bool parseOptions(int argc, char** argv, const Settings& settings, Options& options) {
+        enum {
+            colorOption = 256,
+            fontOption,
+            speedOption,
+            styleOption,
+            shortMessagesOption,
+            loopGapOption,
+            brightnessOption,
+            brightnessModeOption,
+            fadeInOption,
+            lateOption,
+            rotationOption,
+            colorOrderOption,
+            whiteBalanceOption,
+            powerBudgetOption,
+            panelsOption
+        };
+
+        const struct option longOptions[] = {
+            {"frames", required_argument, nullptr, 'n'},
+            {"ppm", required_argument, nullptr, 'p'},
+            {"scale", required_argument, nullptr, 's'},
+            {"ansi", no_argument, nullptr, 'a'},
+            {"quiet", no_argument, nullptr, 'q'},
+            {"help", no_argument, nullptr, 'h'},
+            {"color", required_argument, nullptr, colorOption},
+            {"font", required_argument, nullptr, fontOption},
+            {"speed", required_argument, nullptr, speedOption},
+            {"style", required_argument, nullptr, styleOption},
+            {"short", required_argument, nullptr, shortMessagesOption},
+            {"loop-gap", required_argument, nullptr, loopGapOption},
+            {"brightness", required_argument, nullptr, brightnessOption},
+            {"dim-with", required_argument, nullptr, brightnessModeOption},
+            {"fade-in", required_argument, nullptr, fadeInOption},
+            {"late", required_argument, nullptr, lateOption},
+            {"rotation", required_argument, nullptr, rotationOption},
+            {"color-order", required_argument, nullptr, colorOrderOption},
+            {"white-balance", required_argument, nullptr, whiteBalanceOption},
+            {"power-budget", required_argument, nullptr, powerBudgetOption},
+            {"panels", required_argument, nullptr, panelsOption},
+            {nullptr, 0, nullptr, 0}
+        };
+
+        options.color = settings.colors.currentIndex();
+        options.font = settings.fonts.currentIndex();
+        options.speed = settings.scrollDelays.currentIndex();
+        options.style = settings.scrollStyles.currentIndex();
+        options.shortMessages = settings.shortMessageModes.currentIndex();
+        options.loopGap = settings.loopGaps.currentIndex();
+        options.brightness = settings.brightnessValues.currentIndex();
+        options.brightnessMode = settings.brightnessModes.currentIndex();
+        options.rotation = settings.displayRotations.currentIndex();
+        options.colorOrder = settings.colorOrders.currentIndex();
+
+        int option;
+
+        while ((option = getopt_long(argc, argv, "n:p:s:aqh", longOptions, nullptr)) != -1) {
+            switch (option) {
+                case 'n': options.frames = strtoul(optarg, nullptr, 10); break;
+                case 'p': options.ppmDirectory = optarg; break;
+                case 's': options.ppmScale = constrain(atoi(optarg), 1, 64); break;
+                case 'a': options.ansi = true; break;
+                case 'q': options.quiet = true; break;
+                case colorOption: options.color = atoi(optarg); break;
+                case fontOption: options.font = atoi(optarg); break;
+                case speedOption: options.speed = atoi(optarg); break;
+                case styleOption: options.style = atoi(optarg); break;
+                case shortMessagesOption: options.shortMessages = atoi(optarg); break;
+                case loopGapOption: options.loopGap = atoi(optarg); break;
+                case brightnessOption: options.brightness = atoi(optarg); break;
+                case brightnessModeOption: options.brightnessMode = atoi(optarg); break;
+                case fadeInOption: options.fadeIn = constrain(atoi(optarg), 0, 65535); break;
+                case lateOption: options.late = constrain(atoi(optarg), 0, 65535); break;
+                case rotationOption: options.rotation = atoi(optarg); break;
+                case colorOrderOption: options.colorOrder = atoi(optarg); break;
+                case whiteBalanceOption: options.whiteBalance = optarg; break;
+                case powerBudgetOption: options.powerBudget = constrain(atoi(optarg), 0, 65535); break;
+                case panelsOption: options.panels = constrain(atoi(optarg), 1, int(PanelChain::maxPanels)); break;
+                default: return false;
+            }
+        }
+
+        if (optind < argc) {
+            options.message = argv[optind];
+        }
+
+        if (argc - optind > 1) {
+            options.playlist = argv + optind;
+            options.playlistLength = argc - optind;
+        }
+
+        return true;
+    }
+}
+
+int main(int argc, char** argv) {
+    Settings settings;
+    Options options;
+
+    if (!parseOptions(argc, argv, settings, options)) {
+        printUsage(argv[0], settings);
+        return 1;
+    }
+
+    // Out of range indexes are ignored and leave the default, like the web API.
+    settings.colors.setIndex(options.color);
+    settings.fonts.setIndex(options.font);
+    settings.scrollDelays.setIndex(options.speed);
+    settings.scrollStyles.setIndex(options.style);
+    settings.shortMessageModes.setIndex(options.shortMessages);
+    settings.loopGaps.setIndex(options.loopGap);
+    settings.brightnessValues.setIndex(options.brightness);
+    settings.brightnessModes.setIndex(options.brightnessMode);
+    settings.displayRotations.setIndex(options.rotation);
+    settings.colorOrders.setIndex(options.colorOrder);
+
+    if (options.whiteBalance != nullptr) {
+        settings.whiteBalance = Color::RGB::fromHexString(options.whiteBalance);
+    }
+
+    if (options.powerBudget >= 0) {
+        settings.powerBudget = options.powerBudget;
+    }
+
+    //////////////////////////////
+    // Same object graph as the firmware, minus the web server
+    //////////////////////////////
+    Metrics metrics;
+    SimulatedPanel* simPanels[PanelChain::maxPanels];
+    DisplayPanel* panelList[PanelChain::maxPanels];
+
+    for (uint8_t i = 0; i < options.panels; i++) {
+        simPanels[i] = new SimulatedPanel(metrics);
+        panelList[i] = &simPanels[i]->panel;
+    }
+
+    PanelChain panels(panelList, options.panels);
+    MarqueeController marquee(panels, metrics);
+
+    marquee.setColorOrder(settings.colorOrders.current().value);
+    marquee.setWhiteBalance(settings.whiteBalance);
+    marquee.setPowerBudget(settings.powerBudget);
+    marquee.setRotation(settings.displayRotations.current().value);
+    marquee.setScrollDelay(settings.scrollDelays.current().value);
+    marquee.setSmoothScrolling(settings.scrollStyles.current().value != 0);
+    marquee.setCenterShortMessages(settings.shortMessageModes.current().value != 0);
+    marquee.setLoopGap(settings.loopGaps.current().value);
+    marquee.setFontID(Font::ID(settings.fonts.current().value));
+    marquee.setBrightness(settings.brightnessValues.current().value);
+    marquee.setHardwareBrightness(settings.brightnessModes.current().value != 0);
+    marquee.setColor(Color::RGB::fromHexString(settings.colors.current().hexString));
+
+    MessageText* text = MessageText::fromUTF8(options.message, MarqueeController::maxMessageLength);
+
+    if (text == nullptr) {
+        fprintf(stderr, "Not enough memory for the message\n");
+        return 1;
+    }
+
+    marquee.setMessage(text);
+    text->release();
+
+    if (options.playlistLength > 0) {
+        Playlist* playlist = Playlist::create();
+
+        for (int i = 0; playlist != nullptr && i < options.playlistLength; i++) {
+            MessageText* itemText = MessageText::fromUTF8(options.playlist[i], MarqueeController::maxMessageLength);
+
+            if (itemText == nullptr) {
+                break;
+            }
+
+            Playlist::Item item;
+            item.message = itemText;
+            item.fontID = Font::ID(settings.fonts.current().value);
+            item.color = Color::RGB::fromHexString(settings.colors.current().hexString);
+            item.repeat = 1;
+            item.fontIndex = settings.fonts.currentIndex();
+            item.colorIndex = settings.colors.currentIndex();
+
+            playlist->add(item);
+            itemText->release();
+        }
+
+        if (playlist == nullptr) {
+            fprintf(stderr, "Not enough memory for the playlist\n");
+            return 1;
+        }
+
+        marquee.setPlaylist(playlist);
+        playlist->release();
+    }
+
+    if (options.fadeIn > 0) {
+        marquee.fadeTo(0, 0);
+        marquee.fadeTo(255, options.fadeIn);
+    }
+
+    if (options.ppmDirectory != nullptr) {
+        mkdir(options.ppmDirectory, 0755);
+    }
+
+    //////////////////////////////
+    // Run
+    //////////////////////////////
+    uint8_t pwm[DisplayFlusher::frameSize];
+    uint8_t scaling[DisplayFlusher::frameSize];
+    SimFrame frame;
+    uint64_t simulatedTime = 0;
+    uint32_t lateSeed = 1;
+    uint32_t maxComposeTime = 0;
+    uint64_t totalComposeTime = 0;
+    uint16_t maxLEDCurrent = 0;
+
+    // Frames the display already showed aren't composed again, but they still count, so a held message ends too.
+    while (metrics.frames.get() + metrics.idleFrames.get() < options.frames) {
+        const uint32_t composedBefore = metrics.frames.get();
+        const uint32_t framesBefore = composedBefore + metrics.idleFrames.get();
+        uint32_t dt = marquee.timeUntilNextFrame();
+
+        if (options.late > 0) {
+            // The same lateness every run, so runs can be compared.
+            lateSeed = lateSeed * 1103515245 + 12345;
+            dt += (lateSeed >> 8) % (options.late * 1000 + 1);
+        }
+
+        simulatedTime += dt;
+        marquee.update(dt);
+
+        // Like RenderScheduler, spare time between frames gets the next playlist item ready.
+        if (marquee.timeUntilNextFrame() > 1000) {
+            marquee.prepareNextItem();
+        }
+
+        if (metrics.frames.get() + metrics.idleFrames.get() == framesBefore) {
+            continue;
+        }
+
+        if (metrics.frames.get() != composedBefore) {
+            const uint32_t composeTime = marquee.getLastComposeTime();
+            totalComposeTime += composeTime;
+            maxComposeTime = max(maxComposeTime, composeTime);
+        }
+
+        maxLEDCurrent = max(maxLEDCurrent, marquee.getPowerLimiter().getEstimatedCurrent());
+
+        for (uint8_t i = 0; i < options.panels; i++) {
+            const Adafruit_IS31FL3741_QT_buffered& display = simPanels[i]->display;
+            simPanels[i]->bus.readPWM(pwm);
+            simPanels[i]->bus.readScaling(scaling);
+            frame.read(display, pwm, scaling, i * display.width(), simPanels[i]->bus.globalCurrent());
+        }
+
+        if (options.ppmDirectory != nullptr) {
+            char path[512];
+            snprintf(path, sizeof(path), "%s/frame-%05u.ppm", options.ppmDirectory, framesBefore);
+
+            if (!FrameDump::writePPM(path, frame, options.ppmScale)) {
+                fprintf(stderr, "Could not write %s\n", path);
+                return 1;
+            }
+        }
+
+        if (options.ansi) {
+            FrameDump::writeANSI(stdout, frame, framesBefore > 0);
+            delayMicroseconds(marquee.timeUntilNextFrame());
+        }
+    }
+
+    //////////////////////////////
+    // Summary
+    //////////////////////////////
+    SimulatedDisplayBus::Stats bus;
+    uint32_t busiestPanelBytes = 0;
+
+    for (uint8_t i = 0; i < options.panels; i++) {
+        const SimulatedDisplayBus::Stats& panelBus = simPanels[i]->bus.getStats();
+        bus.bytes += panelBus.bytes;
+        bus.transactions += panelBus.transactions;
+        bus.protocolErrors += panelBus.protocolErrors;
+        busiestPanelBytes = max(busiestPanelBytes, panelBus.bytes);
+    }
+
+    if (!options.quiet) {
+        const uint32_t frames = max(metrics.frames.get(), uint32_t(1));
+
+        fprintf(stderr, "frames:          %u over %u.%03u s simulated\n", metrics.frames.get(), unsigned(simulatedTime / 1000000), unsigned(simulatedTime / 1000 % 1000));
+        fprintf(stderr, "compose time:    %llu us average, %u us max\n", (unsigned long long)(totalComposeTime / frames), maxComposeTime);
+        fprintf(stderr, "display bus:     %u bytes in %u transactions, %u bytes per frame\n", bus.bytes, bus.transactions, bus.bytes / frames);
+        fprintf(stderr, "bytes saved:     %u\n", metrics.displayBytesSaved.get());
+        fprintf(stderr, "LED current:     %u mA estimated max, %u frames power limited\n", maxLEDCurrent, metrics.powerLimitedFrames.get());
+
+        if (metrics.skippedFrames.get() > 0) {
+            fprintf(stderr, "skipped frames:  %u, late\n", metrics.skippedFrames.get());
+        }
+
+        if (metrics.idleFrames.get() > 0) {
+            fprintf(stderr, "idle frames:     %u, not composed or sent\n", metrics.idleFrames.get());
+        }
+
+        if (options.panels > 1) {
+            // Each panel is on its own bus here, so a frame takes as long as the busiest one.
+            fprintf(stderr, "busiest panel:   %u bytes per frame, of %u across %u panels\n", busiestPanelBytes / frames, bus.bytes / frames, options.panels);
+        }
+
+        if (bus.protocolErrors > 0) {
+            fprintf(stderr, "protocol errors: %u\n", bus.protocolErrors);
+        }
+    }
+
+    for (uint8_t i = 0; i < options.panels; i++) {
+        delete simPanels[i];
+    }
+
+    return bus.protocolErrors == 0 ? 0 : 1;
+}
+
+#endif
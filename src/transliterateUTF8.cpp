@@ -57,3 +57,28 @@ bool transliterateUTF8(const char* input, char* output, size_t outputSize) {
     // If we wrote as many bytes as we expected to write, we're good.
     return written == expectedWritten;
 }
+
+size_t transliteratedLength(const char* input) {
+    if (input == nullptr) {
+        return 0;
+    }
+
+	uint32_t utf32;
+	uint32_t state = 0;
+    size_t length = 0;
+
+    while (*input != 0) {
+		utf8_decode(&state, &utf32, (unsigned char) *input);
+
+        if (state == UTF8_ACCEPT) {
+        	const char *r;
+			length += anyascii(utf32, &r);
+        } else if (state == UTF8_REJECT) {
+            state = UTF8_ACCEPT;
+        }
+
+        input++;
+    }
+
+    return length;
+}
@@ -5,4 +5,8 @@
 // Since the MiniMarquee can only render ASCII characters, decode
 // UTF8 characters in the input into ASCII characters so the
 // mini-marquee can render some sensible representation of them..
-bool transliterateUTF8(const char* input, char* output, size_t outputSize);
\ No newline at end of file
+bool transliterateUTF8(const char* input, char* output, size_t outputSize);
+
+// Number of characters transliterateUTF8() would write for input, not counting
+// the null terminator, so the output can be allocated to fit.
+size_t transliteratedLength(const char* input);
\ No newline at end of file
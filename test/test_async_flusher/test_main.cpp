@@ -0,0 +1,162 @@
+// Submits frames to a started AsyncFlusher faster than a slowed down
+// SimulatedDisplayBus can take them, the way the render task does when the
+// I2C bus is busy, and checks that the frames it accepts reach the chip in the
+// order they were submitted, and that once each flush is done the chip holds
+// exactly that frame, never a mix of it and one submitted while it was going out.
+//
+//     pio test -e native -f test_async_flusher
+//     pio test -e native_tsan -f test_async_flusher
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Adafruit_IS31FL3741.h>
+
+#include "../../src/AsyncFlusher.h"
+#include "../../src/DisplayFlusher.h"
+#include "../../src/Metrics.h"
+#include "../../src/sim/SimulatedDisplayBus.h"
+
+namespace {
+    // Each write takes this long (us), so a whole frame takes a few ms.
+    const uint32_t writeTime = 300;
+
+    // How often the render side tries to submit a frame (us).
+    const uint32_t submitInterval = 100;
+
+    const uint32_t framesToSend = 200;
+
+    // A simulated chip on a bus that's slow enough for frames to back up.
+    class SlowDisplayBus : public SimulatedDisplayBus {
+    public:
+        SlowDisplayBus(uint8_t address) :
+            SimulatedDisplayBus(address)
+        {
+
+        }
+
+        bool write(uint8_t address, const uint8_t* data, size_t length) override {
+            delayMicroseconds(writeTime);
+            return SimulatedDisplayBus::write(address, data, length);
+        }
+    };
+
+    // Every frame tried differs from the one before in every byte, so any
+    // part of one left on the chip shows.
+    void fillFrame(uint8_t* frame, uint32_t attempt) {
+        for (uint16_t i = 0; i < DisplayFlusher::frameSize; i++) {
+            frame[i] = attempt * 37 + i;
+        }
+    }
+
+    void fillScaling(uint8_t* scaling, uint32_t attempt) {
+        for (uint16_t i = 0; i < DisplayFlusher::frameSize; i++) {
+            scaling[i] = attempt * 11 + i * 3;
+        }
+    }
+
+    uint8_t globalCurrentFor(uint32_t attempt) {
+        return 1 + attempt % 255;
+    }
+
+    // Whether the chip holds exactly the frame and scaling of those attempts.
+    bool chipHolds(const SimulatedDisplayBus& bus, uint32_t frameAttempt, uint32_t scalingAttempt) {
+        uint8_t expected[DisplayFlusher::frameSize];
+        uint8_t actual[DisplayFlusher::frameSize];
+
+        fillFrame(expected, frameAttempt);
+        bus.readPWM(actual);
+
+        if (memcmp(expected, actual, sizeof(actual)) != 0 || bus.globalCurrent() != globalCurrentFor(frameAttempt)) {
+            return false;
+        }
+
+        fillScaling(expected, scalingAttempt);
+        bus.readScaling(actual);
+        return memcmp(expected, actual, sizeof(actual)) == 0;
+    }
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_frames_arrive_whole_and_in_order() {
+    // The flush task never stops, so what it uses has to outlive the test.
+    static Metrics metrics;
+    static SlowDisplayBus bus(IS3741_ADDR_DEFAULT);
+    static DisplayFlusher flusher(bus, IS3741_ADDR_DEFAULT);
+    static AsyncFlusher asyncFlusher(flusher, metrics);
+    asyncFlusher.begin(1);
+
+    uint8_t frame[DisplayFlusher::frameSize];
+    uint8_t scaling[DisplayFlusher::frameSize];
+    uint32_t attempt = 0;
+    uint32_t accepted = 0;
+    uint32_t refused = 0;
+    uint32_t checked = 0;
+
+    // The attempts whose frame and scaling the chip should end up with.
+    bool anyAccepted = false;
+    uint32_t lastFrame = 0;
+    uint32_t lastScaling = 0;
+
+    while (accepted < framesToSend) {
+        // Only the flush task finishing can make it idle, and only this
+        // thread submits, so the last frame accepted is on the chip now.
+        const bool idle = asyncFlusher.isIdle();
+
+        if (idle && anyAccepted) {
+            if (!chipHolds(bus, lastFrame, lastScaling)) {
+                char description[96];
+                snprintf(description, sizeof(description), "the chip doesn't hold frame %u (with scaling %u) whole", unsigned(lastFrame), unsigned(lastScaling));
+                TEST_FAIL_MESSAGE(description);
+            }
+
+            checked++;
+        }
+
+        // Every few frames carry the white balance too.
+        const bool withScaling = attempt % 5 == 0;
+        fillFrame(frame, attempt);
+        fillScaling(scaling, attempt);
+
+        if (asyncFlusher.submit(frame, globalCurrentFor(attempt), withScaling ? scaling : nullptr)) {
+            accepted++;
+            anyAccepted = true;
+            lastFrame = attempt;
+
+            if (withScaling) {
+                lastScaling = attempt;
+            }
+        } else {
+            TEST_ASSERT_FALSE_MESSAGE(idle, "an idle flusher refused a frame");
+            refused++;
+        }
+
+        attempt++;
+        delayMicroseconds(submitInterval);
+    }
+
+    while (!asyncFlusher.isIdle()) {
+        delayMicroseconds(submitInterval);
+    }
+
+    TEST_ASSERT_TRUE(chipHolds(bus, lastFrame, lastScaling));
+    TEST_ASSERT_EQUAL_UINT32(0, bus.getStats().protocolErrors);
+
+    // Frames did back up behind the bus, and nearly every accepted one was
+    // seen whole. One misses its check only when its flush finishes between
+    // the check and the next submit.
+    TEST_ASSERT_GREATER_THAN_UINT32(accepted, refused);
+    TEST_ASSERT_GREATER_THAN_UINT32(accepted * 3 / 4, checked);
+
+    printf("%u frames sent, %u refused while busy, %u checked on the chip\n", unsigned(accepted), unsigned(refused), unsigned(checked));
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_frames_arrive_whole_and_in_order);
+    return UNITY_END();
+}
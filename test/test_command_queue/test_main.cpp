@@ -0,0 +1,202 @@
+// The web server task posts changes to the marquee while the render task is
+// drawing frames. Here a producer thread stands in for the web server and
+// hammers the post functions while the test thread calls update() the way the
+// render task does, checking after every update that the commands were applied
+// in the order they were posted, and none were lost or applied twice.
+//
+//     pio test -e native -f test_command_queue
+//     pio test -e native_tsan -f test_command_queue
+//
+// The second runs it under ThreadSanitizer, which also checks the queue's
+// memory ordering and the sharing of the message text between the threads.
+
+#include <Arduino.h>
+#include <unity.h>
+#include <atomic>
+#include <thread>
+
+#include "../../src/MarqueeController.h"
+#include "../../src/PanelChain.h"
+#include "../../src/Metrics.h"
+#include "../../src/MessageText.h"
+#include "../../src/sim/SimulatedPanel.h"
+
+namespace {
+    const uint32_t commandPairs = 20000;
+
+    // Each message is followed by a scroll delay of its own, which is never
+    // the same as the one before it, so the pair a state came from can be told.
+    uint8_t scrollDelayFor(uint32_t index) {
+        return 1 + index % 200;
+    }
+
+    // Returns false for the marquee's initial message.
+    bool messageIndex(const char* message, uint32_t& index) {
+        unsigned parsed;
+
+        if (sscanf(message, "message %u", &parsed) != 1) {
+            return false;
+        }
+
+        index = parsed;
+        return true;
+    }
+
+    struct Harness {
+        Harness() :
+            simulated(metrics),
+            panel(&simulated.panel),
+            panels(&panel, 1),
+            marquee(panels, metrics)
+        {
+
+        }
+
+        Metrics metrics;
+        SimulatedPanel simulated;
+        DisplayPanel* panel;
+        PanelChain panels;
+        MarqueeController marquee;
+    };
+
+    // What the test thread saw, kept until the producer has stopped so the
+    // assertions don't leave it running.
+    struct Failure {
+        const char* reason = nullptr;
+        uint32_t message = 0;
+        uint8_t scrollDelay = 0;
+    };
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_commands_are_applied_in_order_and_none_are_lost() {
+    Harness harness;
+    MarqueeController& marquee = harness.marquee;
+    const uint8_t initialScrollDelay = marquee.getScrollDelay();
+
+    std::atomic<bool> stop{false};
+    std::atomic<bool> producerDone{false};
+    uint32_t queueFull = 0;
+
+    std::thread producer([&]() {
+        char text[32];
+
+        for (uint32_t i = 0; i < commandPairs && !stop.load(); i++) {
+            snprintf(text, sizeof(text), "message %u", unsigned(i));
+
+            // Like the web server, which answers 503 and has the client try again.
+            while (!marquee.postMessage(text) && !stop.load()) {
+                queueFull++;
+                std::this_thread::yield();
+            }
+
+            while (!marquee.postScrollDelay(scrollDelayFor(i)) && !stop.load()) {
+                queueFull++;
+                std::this_thread::yield();
+            }
+        }
+
+        producerDone.store(true);
+    });
+
+    Failure failure;
+    uint32_t lastMessage = 0;
+    bool seenMessage = false;
+    uint32_t updates = 0;
+
+    while (failure.reason == nullptr) {
+        // Once the producer's done, one more update applies whatever it posted last.
+        const bool finalUpdate = producerDone.load();
+        marquee.update(1000);
+        updates++;
+
+        uint32_t message = 0;
+        const uint8_t scrollDelay = marquee.getScrollDelay();
+
+        if (!messageIndex(marquee.getMessage(), message)) {
+            if (seenMessage) {
+                failure.reason = "went back to the initial message";
+            } else if (scrollDelay != initialScrollDelay) {
+                failure.reason = "a scroll delay was applied before its message";
+            }
+        } else if (seenMessage && message < lastMessage) {
+            failure.reason = "messages were applied out of order";
+        } else {
+            // Either the message's own delay has been applied too, or it's still queued behind it.
+            const uint8_t previousDelay = (message > 0) ? scrollDelayFor(message - 1) : initialScrollDelay;
+
+            if (scrollDelay != scrollDelayFor(message) && scrollDelay != previousDelay) {
+                failure.reason = "the scroll delay doesn't go with the message";
+            }
+
+            seenMessage = true;
+            lastMessage = message;
+        }
+
+        if (failure.reason != nullptr) {
+            failure.message = message;
+            failure.scrollDelay = scrollDelay;
+        }
+
+        if (finalUpdate) {
+            break;
+        }
+
+        // The render task sleeps between frames, which is when the web server gets to post.
+        std::this_thread::yield();
+    }
+
+    stop.store(true);
+    producer.join();
+
+    if (failure.reason != nullptr) {
+        char description[128];
+        snprintf(description, sizeof(description), "%s (message %u, scroll delay %u)", failure.reason, unsigned(failure.message), failure.scrollDelay);
+        TEST_FAIL_MESSAGE(description);
+    }
+
+    // The last of everything posted is what's left.
+    char lastText[32];
+    snprintf(lastText, sizeof(lastText), "message %u", unsigned(commandPairs - 1));
+    TEST_ASSERT_EQUAL_STRING(lastText, marquee.getMessage());
+    TEST_ASSERT_EQUAL_UINT8(scrollDelayFor(commandPairs - 1), marquee.getScrollDelay());
+
+    // Nothing's left in the queue for another update to apply.
+    marquee.update(1000);
+    TEST_ASSERT_EQUAL_STRING(lastText, marquee.getMessage());
+
+    printf("%u updates, the queue was full %u times\n", unsigned(updates), unsigned(queueFull));
+}
+
+// A queued message holds a reference of its own, so the poster can let go of
+// it straight away, and a command that couldn't be queued leaves it alone.
+void test_posted_message_outlives_the_poster() {
+    Harness harness;
+    MarqueeController& marquee = harness.marquee;
+    MessageText* text = MessageText::copy("shared", MarqueeController::maxMessageLength);
+    TEST_ASSERT_NOT_NULL(text);
+
+    uint32_t posted = 0;
+
+    while (marquee.postMessage(text)) {
+        posted++;
+    }
+
+    TEST_ASSERT_GREATER_THAN(0, posted);
+    text->release();
+
+    marquee.update(1000);
+    TEST_ASSERT_EQUAL_STRING("shared", marquee.getMessage());
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_commands_are_applied_in_order_and_none_are_lost);
+    RUN_TEST(test_posted_message_outlives_the_poster);
+    return UNITY_END();
+}
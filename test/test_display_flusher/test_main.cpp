@@ -0,0 +1,397 @@
+// Flushes frames through a DisplayFlusher to a SimulatedDisplayBus and checks
+// the writes it logged: only the registers that changed go out, in bursts
+// merged and split the way DisplayFlusher says, with a page select only when
+// the page changes, and everything again after a write fails. After every
+// flush the chip's registers have to hold the frame.
+//
+//     pio test -e native -f test_display_flusher
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Adafruit_IS31FL3741.h>
+
+#include "../../src/DisplayFlusher.h"
+#include "../../src/sim/SimulatedDisplayBus.h"
+
+namespace {
+    const uint8_t address = IS3741_ADDR_DEFAULT;
+    const uint8_t globalCurrent = 0x80;
+
+    // IS31FL3741 registers, as DisplayFlusher uses them.
+    const uint8_t commandRegister = 0xFD;
+    const uint8_t commandRegisterLock = 0xFE;
+    const uint8_t configPage = 4;
+
+    // PWM registers 0-179 are in page 0, the rest in page 1.
+    const uint16_t page0Size = 180;
+
+    // The device address, register address and data, for one logged write.
+    uint16_t wireBytes(const SimulatedDisplayBus::Transaction& transaction) {
+        return transaction.length + 2;
+    }
+
+    bool isPWMWrite(const SimulatedDisplayBus::Transaction& transaction) {
+        return (transaction.page == 0 || transaction.page == 1) && transaction.reg != commandRegister && transaction.reg != commandRegisterLock;
+    }
+
+    bool isPageSelect(const SimulatedDisplayBus::Transaction& transaction) {
+        return transaction.reg == commandRegister;
+    }
+
+    // The logged PWM writes, in order, as frame offsets and lengths.
+    struct Burst {
+        uint16_t start;
+        uint16_t length;
+    };
+
+    uint8_t pwmBursts(const SimulatedDisplayBus& bus, Burst* bursts, uint8_t maxBursts) {
+        uint8_t count = 0;
+
+        for (uint16_t i = 0; i < bus.transactionCount() && count < maxBursts; i++) {
+            const SimulatedDisplayBus::Transaction& transaction = bus.transaction(i);
+
+            if (isPWMWrite(transaction)) {
+                bursts[count].start = transaction.reg + (transaction.page == 1 ? page0Size : 0);
+                bursts[count].length = transaction.length;
+                count++;
+            }
+        }
+
+        return count;
+    }
+
+    uint16_t pwmBytesSent(const SimulatedDisplayBus& bus) {
+        uint16_t bytes = 0;
+
+        for (uint16_t i = 0; i < bus.transactionCount(); i++) {
+            if (isPWMWrite(bus.transaction(i))) {
+                bytes += bus.transaction(i).length;
+            }
+        }
+
+        return bytes;
+    }
+
+    uint8_t pageSelects(const SimulatedDisplayBus& bus) {
+        uint8_t selects = 0;
+
+        for (uint16_t i = 0; i < bus.transactionCount(); i++) {
+            selects += isPageSelect(bus.transaction(i));
+        }
+
+        return selects;
+    }
+
+    void fillFrame(uint8_t* frame, uint8_t seed) {
+        for (uint16_t i = 0; i < DisplayFlusher::frameSize; i++) {
+            frame[i] = seed + i * 7;
+        }
+    }
+
+    // A chip on a bus that stops acknowledging after a number of writes.
+    class FailingDisplayBus : public SimulatedDisplayBus {
+    public:
+        FailingDisplayBus(uint8_t address) :
+            SimulatedDisplayBus(address)
+        {
+
+        }
+
+        bool write(uint8_t address, const uint8_t* data, size_t length) override {
+            if (writesUntilFailure == 0) {
+                writesUntilFailure = -1;
+                return false;
+            }
+
+            if (writesUntilFailure > 0) {
+                writesUntilFailure--;
+            }
+
+            return SimulatedDisplayBus::write(address, data, length);
+        }
+
+        // -1 never fails.
+        int32_t writesUntilFailure = -1;
+    };
+
+    // Flushes frame with a clean log, and checks that what went out is what
+    // the stats say, that nothing broke the chip's rules, and that the chip
+    // ends up holding the frame.
+    void flushAndCheck(DisplayFlusher& flusher, SimulatedDisplayBus& bus, const uint8_t* frame) {
+        bus.clearLog();
+        const uint32_t errorsBefore = bus.getStats().protocolErrors;
+        TEST_ASSERT_TRUE(flusher.flush(frame, globalCurrent));
+
+        uint16_t wire = 0;
+
+        for (uint16_t i = 0; i < bus.transactionCount(); i++) {
+            const SimulatedDisplayBus::Transaction& transaction = bus.transaction(i);
+            TEST_ASSERT_EQUAL_UINT8(address, transaction.address);
+            TEST_ASSERT_LESS_OR_EQUAL_UINT32(DisplayFlusher::maxTransferSize - 1, transaction.length);
+            wire += wireBytes(transaction);
+        }
+
+        TEST_ASSERT_LESS_THAN(SimulatedDisplayBus::logSize, bus.transactionCount());
+        TEST_ASSERT_EQUAL_UINT16(wire, flusher.lastFrameStats().bytesSent);
+        TEST_ASSERT_EQUAL_UINT32(bus.transactionCount(), flusher.lastFrameStats().transactions);
+        TEST_ASSERT_EQUAL_UINT32(errorsBefore, bus.getStats().protocolErrors);
+
+        uint8_t registers[DisplayFlusher::frameSize];
+        bus.readPWM(registers);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(frame, registers, DisplayFlusher::frameSize);
+        TEST_ASSERT_EQUAL_UINT8(globalCurrent, bus.globalCurrent());
+    }
+
+    // Bytes the first, whole frame took, without the global current that went out after it.
+    void flushWhole(DisplayFlusher& flusher, SimulatedDisplayBus& bus, const uint8_t* frame, uint16_t& cost) {
+        flushAndCheck(flusher, bus, frame);
+
+        // Unlock, select the configuration page, write the global current.
+        const uint16_t count = bus.transactionCount();
+        TEST_ASSERT_GREATER_THAN(3, count);
+        TEST_ASSERT_EQUAL_UINT8(commandRegisterLock, bus.transaction(count - 3).reg);
+        TEST_ASSERT_TRUE(isPageSelect(bus.transaction(count - 2)));
+        TEST_ASSERT_EQUAL_INT(configPage, bus.transaction(count - 1).page);
+
+        cost = flusher.lastFrameStats().bytesSent;
+
+        for (uint16_t i = count - 3; i < count; i++) {
+            cost -= wireBytes(bus.transaction(i));
+        }
+    }
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_first_frame_goes_out_whole() {
+    SimulatedDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 1);
+
+    flushAndCheck(flusher, bus, frame);
+    TEST_ASSERT_EQUAL_UINT16(DisplayFlusher::frameSize, pwmBytesSent(bus));
+
+    // Nothing was saved on a frame that had to go out whole.
+    TEST_ASSERT_EQUAL_UINT16(0, flusher.lastFrameStats().bytesSaved);
+}
+
+void test_identical_frame_sends_nothing() {
+    SimulatedDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 2);
+
+    uint16_t cost = 0;
+    flushWhole(flusher, bus, frame, cost);
+    TEST_ASSERT_GREATER_THAN(DisplayFlusher::frameSize, cost);
+
+    flushAndCheck(flusher, bus, frame);
+    TEST_ASSERT_EQUAL_UINT16(0, bus.transactionCount());
+    TEST_ASSERT_EQUAL_UINT16(0, flusher.lastFrameStats().bytesSent);
+
+    // The whole frame was saved: its registers, and the addressing and page selects they'd have taken.
+    TEST_ASSERT_EQUAL_UINT16(cost, flusher.lastFrameStats().bytesSaved);
+}
+
+void test_one_changed_byte_is_one_burst() {
+    SimulatedDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 3);
+    uint16_t cost = 0;
+    flushWhole(flusher, bus, frame, cost);
+
+    for (uint16_t changed : {uint16_t(0), uint16_t(57), uint16_t(179), uint16_t(180), uint16_t(200), uint16_t(350)}) {
+        frame[changed]++;
+        flushAndCheck(flusher, bus, frame);
+
+        Burst bursts[4];
+        TEST_ASSERT_EQUAL_UINT8(1, pwmBursts(bus, bursts, 4));
+        TEST_ASSERT_EQUAL_UINT16(changed, bursts[0].start);
+        TEST_ASSERT_EQUAL_UINT16(1, bursts[0].length);
+
+        const DisplayFlusher::Stats& stats = flusher.lastFrameStats();
+        TEST_ASSERT_EQUAL_UINT16(cost - stats.bytesSent, stats.bytesSaved);
+    }
+}
+
+void test_nearby_changes_merge() {
+    SimulatedDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 4);
+    flushAndCheck(flusher, bus, frame);
+
+    // mergeGap unchanged bytes between two changes are cheaper to resend.
+    const uint16_t gap = DisplayFlusher::mergeGap;
+    frame[10]++;
+    frame[10 + gap + 1]++;
+    flushAndCheck(flusher, bus, frame);
+
+    Burst bursts[4];
+    TEST_ASSERT_EQUAL_UINT8(1, pwmBursts(bus, bursts, 4));
+    TEST_ASSERT_EQUAL_UINT16(10, bursts[0].start);
+    TEST_ASSERT_EQUAL_UINT16(gap + 2, bursts[0].length);
+
+    // One more, and they're two bursts.
+    frame[100]++;
+    frame[100 + gap + 2]++;
+    flushAndCheck(flusher, bus, frame);
+
+    TEST_ASSERT_EQUAL_UINT8(2, pwmBursts(bus, bursts, 4));
+    TEST_ASSERT_EQUAL_UINT16(100, bursts[0].start);
+    TEST_ASSERT_EQUAL_UINT16(1, bursts[0].length);
+    TEST_ASSERT_EQUAL_UINT16(100 + gap + 2, bursts[1].start);
+    TEST_ASSERT_EQUAL_UINT16(1, bursts[1].length);
+}
+
+void test_change_across_pages_selects_each_once() {
+    SimulatedDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 5);
+    flushAndCheck(flusher, bus, frame);
+
+    // Settle on page 1 first, so the change below only has to leave it once.
+    frame[300]++;
+    flushAndCheck(flusher, bus, frame);
+
+    for (uint16_t i = page0Size - 2; i < page0Size + 3; i++) {
+        frame[i]++;
+    }
+
+    flushAndCheck(flusher, bus, frame);
+
+    // Bursts can't cross a page, so it's split at the boundary.
+    Burst bursts[4];
+    TEST_ASSERT_EQUAL_UINT8(2, pwmBursts(bus, bursts, 4));
+    TEST_ASSERT_EQUAL_UINT16(page0Size - 2, bursts[0].start);
+    TEST_ASSERT_EQUAL_UINT16(2, bursts[0].length);
+    TEST_ASSERT_EQUAL_UINT16(page0Size, bursts[1].start);
+    TEST_ASSERT_EQUAL_UINT16(3, bursts[1].length);
+
+    // Back to page 0, then page 1 exactly once, each unlocked first.
+    TEST_ASSERT_EQUAL_UINT16(6, bus.transactionCount());
+    TEST_ASSERT_EQUAL_UINT8(2, pageSelects(bus));
+    TEST_ASSERT_EQUAL_UINT8(commandRegisterLock, bus.transaction(3).reg);
+    TEST_ASSERT_TRUE(isPageSelect(bus.transaction(4)));
+    TEST_ASSERT_EQUAL_INT(0, bus.transaction(4).page);
+    TEST_ASSERT_EQUAL_INT(1, bus.transaction(5).page);
+
+    // Changes in one page don't select it again.
+    frame[10]++;
+    frame[100]++;
+    frame[170]++;
+    flushAndCheck(flusher, bus, frame);
+    TEST_ASSERT_EQUAL_UINT8(3, pwmBursts(bus, bursts, 4));
+    TEST_ASSERT_EQUAL_UINT8(1, pageSelects(bus));
+}
+
+void test_long_runs_are_split() {
+    for (size_t maxWrite : {size_t(128), size_t(32)}) {
+        SimulatedDisplayBus bus(address, maxWrite);
+        DisplayFlusher flusher(bus, address);
+        uint8_t frame[DisplayFlusher::frameSize];
+        fillFrame(frame, 6);
+        flushAndCheck(flusher, bus, frame);
+
+        // All of page 0 changes.
+        for (uint16_t i = 0; i < page0Size; i++) {
+            frame[i]++;
+        }
+
+        flushAndCheck(flusher, bus, frame);
+
+        // As long as the bus and the flusher's buffer allow, register address included.
+        const uint16_t maxRun = min(maxWrite, size_t(DisplayFlusher::maxTransferSize)) - 1;
+        const uint8_t expectedBursts = (page0Size + maxRun - 1) / maxRun;
+
+        Burst bursts[16];
+        TEST_ASSERT_EQUAL_UINT8(expectedBursts, pwmBursts(bus, bursts, 16));
+
+        uint16_t next = 0;
+
+        for (uint8_t i = 0; i < expectedBursts; i++) {
+            TEST_ASSERT_EQUAL_UINT16(next, bursts[i].start);
+            TEST_ASSERT_EQUAL_UINT16(min(uint16_t(page0Size - next), maxRun), bursts[i].length);
+            next += bursts[i].length;
+        }
+    }
+}
+
+void test_failed_write_resends_everything() {
+    FailingDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 7);
+    flushAndCheck(flusher, bus, frame);
+
+    // The change's page select goes through, then its burst fails.
+    frame[20]++;
+    bus.clearLog();
+    bus.writesUntilFailure = 2;
+    TEST_ASSERT_FALSE(flusher.flush(frame, globalCurrent));
+
+    // Not knowing what the chip got, the next flush sends all of it again,
+    // the global current too, even though the frame is the same.
+    flushAndCheck(flusher, bus, frame);
+    TEST_ASSERT_EQUAL_UINT16(DisplayFlusher::frameSize, pwmBytesSent(bus));
+    TEST_ASSERT_EQUAL_UINT8(configPage, bus.transaction(bus.transactionCount() - 1).page);
+
+    // And after that it's back to sending only what changed.
+    frame[20]++;
+    flushAndCheck(flusher, bus, frame);
+    TEST_ASSERT_EQUAL_UINT16(1, pwmBytesSent(bus));
+}
+
+// Random edits, each frame checked against the chip's registers.
+void test_chip_holds_every_frame() {
+    SimulatedDisplayBus bus(address);
+    DisplayFlusher flusher(bus, address);
+    uint8_t frame[DisplayFlusher::frameSize];
+    fillFrame(frame, 8);
+    flushAndCheck(flusher, bus, frame);
+
+    uint32_t seed = 1;
+
+    for (uint16_t f = 0; f < 500; f++) {
+        seed = seed * 1103515245 + 12345;
+        const uint16_t edits = (seed >> 16) % 40;
+        uint16_t changed = 0;
+
+        for (uint16_t e = 0; e < edits; e++) {
+            seed = seed * 1103515245 + 12345;
+            const uint16_t i = (seed >> 8) % DisplayFlusher::frameSize;
+            const uint8_t value = seed >> 24;
+
+            if (frame[i] != value) {
+                frame[i] = value;
+                changed++;
+            }
+        }
+
+        flushAndCheck(flusher, bus, frame);
+
+        // At least the changed registers go out, with at most mergeGap unchanged ones between each.
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(changed > 0 ? 1 : 0, pwmBytesSent(bus));
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(changed * (DisplayFlusher::mergeGap + 1), pwmBytesSent(bus));
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_first_frame_goes_out_whole);
+    RUN_TEST(test_identical_frame_sends_nothing);
+    RUN_TEST(test_one_changed_byte_is_one_burst);
+    RUN_TEST(test_nearby_changes_merge);
+    RUN_TEST(test_change_across_pages_selects_each_once);
+    RUN_TEST(test_long_runs_are_split);
+    RUN_TEST(test_failed_write_resends_everything);
+    RUN_TEST(test_chip_holds_every_frame);
+    return UNITY_END();
+}
@@ -0,0 +1,214 @@
+// Scrolls a message across chains of two to four simulated matrices, each
+// chip at its own address on one shared bus the way chained boards are wired,
+// and checks what the chips end up showing: every column moves one step left
+// each frame, including across the edges between panels, and each panel's
+// part of the frame only ever goes to its own chip.
+//
+//     pio test -e native -f test_panel_chain
+
+#include <Arduino.h>
+#include <unity.h>
+#include <Adafruit_IS31FL3741.h>
+#include <memory>
+
+#include "../../src/MarqueeController.h"
+#include "../../src/PanelChain.h"
+#include "../../src/DisplayPanel.h"
+#include "../../src/DisplayFlusher.h"
+#include "../../src/AsyncFlusher.h"
+#include "../../src/Metrics.h"
+#include "../../src/sim/SimulatedDisplayBus.h"
+#include "../../src/sim/FrameDump.h"
+
+namespace {
+    const uint8_t scrollDelay = 20;
+    const char* message = "Chained panels 0123456789";
+
+    // Chips on one I2C bus, each answering to its own address.
+    class SharedBus : public I2CBus {
+    public:
+        bool write(uint8_t address, const uint8_t* data, size_t length) override {
+            for (uint8_t i = 0; i < chipCount; i++) {
+                if (addresses[i] == address) {
+                    return chips[i]->write(address, data, length);
+                }
+            }
+
+            // Nothing would acknowledge it.
+            unanswered++;
+            return false;
+        }
+
+        size_t maxWriteSize() const override {
+            return 128;
+        }
+
+        void attach(uint8_t address, SimulatedDisplayBus& chip) {
+            addresses[chipCount] = address;
+            chips[chipCount] = &chip;
+            chipCount++;
+        }
+
+        uint32_t unanswered = 0;
+
+    private:
+        uint8_t addresses[PanelChain::maxPanels];
+        SimulatedDisplayBus* chips[PanelChain::maxPanels];
+        uint8_t chipCount = 0;
+    };
+
+    // One matrix, flushed synchronously to its chip on the shared bus.
+    struct ChainedPanel {
+        ChainedPanel(SharedBus& shared, Metrics& metrics, uint8_t address) :
+            display(MARQUEE_COLOR_ORDER),
+            chip(address),
+            flusher(shared, address),
+            asyncFlusher(flusher, metrics),
+            panel(display, asyncFlusher)
+        {
+            shared.attach(address, chip);
+        }
+
+        Adafruit_IS31FL3741_QT_buffered display;
+        SimulatedDisplayBus chip;
+        DisplayFlusher flusher;
+        AsyncFlusher asyncFlusher;
+        DisplayPanel panel;
+    };
+
+    // Reads what the chips show into frame, panel by panel, left to right.
+    void readChips(const std::unique_ptr<ChainedPanel>* chained, uint8_t count, SimFrame& frame) {
+        uint8_t pwm[DisplayFlusher::frameSize];
+        uint8_t scaling[DisplayFlusher::frameSize];
+
+        for (uint8_t i = 0; i < count; i++) {
+            const Adafruit_IS31FL3741_QT_buffered& display = chained[i]->display;
+            chained[i]->chip.readPWM(pwm);
+            chained[i]->chip.readScaling(scaling);
+            frame.read(display, pwm, scaling, i * display.width(), chained[i]->chip.globalCurrent());
+        }
+    }
+
+    bool columnsMatch(const SimFrame& a, int16_t aColumn, const SimFrame& b, int16_t bColumn) {
+        for (int16_t y = 0; y < a.height; y++) {
+            if (memcmp(a.rgb[y][aColumn], b.rgb[y][bColumn], 3) != 0) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool columnLit(const SimFrame& frame, int16_t column) {
+        for (int16_t y = 0; y < frame.height; y++) {
+            const uint8_t* pixel = frame.rgb[y][column];
+
+            if (pixel[0] != 0 || pixel[1] != 0 || pixel[2] != 0) {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    void testChain(uint8_t count, uint8_t rotation) {
+        Metrics metrics;
+        SharedBus shared;
+        std::unique_ptr<ChainedPanel> chained[PanelChain::maxPanels];
+        DisplayPanel* panelList[PanelChain::maxPanels];
+
+        // The IS31FL3741's four selectable addresses.
+        for (uint8_t i = 0; i < count; i++) {
+            chained[i].reset(new ChainedPanel(shared, metrics, IS3741_ADDR_DEFAULT + i));
+            panelList[i] = &chained[i]->panel;
+        }
+
+        PanelChain panels(panelList, count);
+        MarqueeController marquee(panels, metrics);
+        marquee.setRotation(rotation);
+        marquee.setScrollDelay(scrollDelay);
+        marquee.setColor(0xFFFFFF);
+        marquee.setMessage(message);
+
+        const int16_t width = panels.width();
+        const int16_t panelWidth = width / count;
+        TEST_ASSERT_EQUAL(count * chained[0]->display.width(), width);
+
+        // Whether anything lit has scrolled across the edge between panel i - 1 and panel i.
+        bool crossed[PanelChain::maxPanels] = {false};
+
+        SimFrame previous;
+        SimFrame frame;
+        marquee.update(scrollDelay * 1000);
+        readChips(chained, count, previous);
+        TEST_ASSERT_EQUAL(width, previous.width);
+
+        // Two passes across the whole canvas, in the 6 column wide classic font.
+        const uint32_t frames = 2 * (width + strlen(message) * 6 + 1);
+
+        for (uint32_t f = 0; f < frames; f++) {
+            marquee.update(scrollDelay * 1000);
+            readChips(chained, count, frame);
+
+            // Every column moved one step left, whichever panels it was on.
+            for (int16_t x = 0; x + 1 < width; x++) {
+                if (!columnsMatch(frame, x, previous, x + 1)) {
+                    char description[96];
+                    snprintf(description, sizeof(description), "column %d of frame %u isn't column %d of the frame before", x, unsigned(f), x + 1);
+                    TEST_FAIL_MESSAGE(description);
+                }
+            }
+
+            for (uint8_t i = 1; i < count; i++) {
+                crossed[i] |= columnLit(frame, i * panelWidth - 1) && columnLit(previous, i * panelWidth);
+            }
+
+            previous = frame;
+        }
+
+        for (uint8_t i = 1; i < count; i++) {
+            TEST_ASSERT_TRUE_MESSAGE(crossed[i], "nothing lit crossed the edge between two panels");
+        }
+
+        // Each panel's writes went to its own chip, and only there.
+        TEST_ASSERT_EQUAL_UINT32(0, shared.unanswered);
+
+        for (uint8_t i = 0; i < count; i++) {
+            const SimulatedDisplayBus::Stats& stats = chained[i]->chip.getStats();
+            TEST_ASSERT_GREATER_THAN_UINT32(0, stats.transactions);
+            TEST_ASSERT_EQUAL_UINT32(0, stats.protocolErrors);
+        }
+    }
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_two_panels() {
+    testChain(2, 0);
+}
+
+void test_three_panels() {
+    testChain(3, 0);
+}
+
+void test_four_panels() {
+    testChain(4, 0);
+}
+
+// Upside down, the panels are still left to right as seen from the front.
+void test_four_panels_rotated() {
+    testChain(4, 2);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_two_panels);
+    RUN_TEST(test_three_panels);
+    RUN_TEST(test_four_panels);
+    RUN_TEST(test_four_panels_rotated);
+    return UNITY_END();
+}
@@ -0,0 +1,206 @@
+// Scrolls messages under a power budget on the fake clock from
+// test_render_timing, changing the color, brightness and white balance part
+// way through, and checks the LED current estimate on every step: the load
+// PowerLimiter was given, kept up to date a column at a time as the window
+// scrolls, has to match a full recount of what the chip holds, PWM times
+// scaling, and the global current cap only comes down when a frame would go
+// over the budget and only goes back up while frames fit under it with the
+// 1/8 margin to spare.
+//
+//     pio test -e native -f test_power_limit
+
+#include <Arduino.h>
+#include <unity.h>
+
+#include "../../src/MarqueeController.h"
+#include "../../src/RenderScheduler.h"
+#include "../../src/PanelChain.h"
+#include "../../src/PowerLimiter.h"
+#include "../../src/Metrics.h"
+#include "../../src/sim/SimulatedPanel.h"
+
+namespace {
+    // Starts 2 s short of the microsecond clock wrapping, so every run goes over it.
+    const uint32_t startTime = 0xFFFFFFFF - 2000000;
+
+    const uint8_t scrollDelay = 20;
+    const char* message = "Power limited 0123456789 ###";
+
+    // About what a dozen LEDs lit white draw, so the message goes over it
+    // white and fits under it in one color or dimmed.
+    const uint16_t budget = 150;
+
+    // Each part of a run, between changes (us).
+    const uint32_t partTime = 2000000;
+
+    struct Harness {
+        Harness() :
+            simulated(metrics),
+            panel(&simulated.panel),
+            panels(&panel, 1),
+            marquee(panels, metrics),
+            scheduler(marquee, metrics)
+        {
+            marquee.setScrollDelay(scrollDelay);
+            marquee.setColor(0xFFFFFF);
+            marquee.setPowerBudget(budget);
+        }
+
+        Metrics metrics;
+        SimulatedPanel simulated;
+        DisplayPanel* panel;
+        PanelChain panels;
+        MarqueeController marquee;
+        RenderScheduler scheduler;
+    };
+
+    struct Counts {
+        uint32_t steps = 0;
+        uint32_t drops = 0;
+        uint32_t rises = 0;
+    };
+
+    // The load of what the chip holds: each LED channel's PWM times its scaling.
+    // Also the most blending can round that down by, a PWM step per channel.
+    void recount(const SimulatedDisplayBus& bus, uint32_t& load, uint32_t& rounding) {
+        uint8_t pwm[DisplayFlusher::frameSize];
+        uint8_t scaling[DisplayFlusher::frameSize];
+        bus.readPWM(pwm);
+        bus.readScaling(scaling);
+
+        load = 0;
+        rounding = 0;
+
+        for (uint16_t i = 0; i < DisplayFlusher::frameSize; i++) {
+            load += pwm[i] * scaling[i];
+            rounding += scaling[i];
+        }
+    }
+
+    // The LED current of a frame with load at the full global current, the way PowerLimiter works it out (uA).
+    uint64_t fullCurrent(uint32_t load) {
+        return uint64_t(load) * PowerLimiter::channelMicroamps / (255 * 255);
+    }
+
+    // Steps the scheduler for duration us, up to two frames late, checking the load and the cap after each step.
+    void run(Harness& harness, uint32_t& now, uint32_t duration, bool blended, Counts& counts) {
+        const PowerLimiter& limiter = harness.marquee.getPowerLimiter();
+        const uint64_t budgetMicroamps = uint64_t(budget) * 1000;
+        const uint64_t releaseBudget = budgetMicroamps - (budgetMicroamps >> PowerLimiter::releaseMarginShift);
+        const uint32_t end = now + duration;
+        uint32_t seed = 1;
+
+        while (int32_t(end - now) > 0) {
+            const uint8_t previousMax = limiter.getMaxGlobalCurrent();
+            const uint32_t due = harness.scheduler.step(now);
+            counts.steps++;
+
+            uint32_t load, rounding;
+            recount(harness.simulated.bus, load, rounding);
+
+            // A blended frame's load is worked out from the two whole pixel
+            // windows it's between, so each channel can be under it by less than a step.
+            if (blended) {
+                TEST_ASSERT_LESS_OR_EQUAL_UINT32(limiter.getLoad() + 1, load);
+                TEST_ASSERT_LESS_OR_EQUAL_UINT32(load + rounding, limiter.getLoad());
+            } else {
+                TEST_ASSERT_EQUAL_UINT32(load, limiter.getLoad());
+            }
+
+            const uint64_t current = fullCurrent(limiter.getLoad());
+            const uint8_t max = limiter.getMaxGlobalCurrent();
+
+            // Whatever the cap did, the frame fits under the budget with it.
+            TEST_ASSERT_TRUE(current * max <= budgetMicroamps * 255);
+
+            if (max < previousMax) {
+                // Down only because the frame wouldn't have fit under the old cap, and only as far as it has to.
+                TEST_ASSERT_TRUE(current * (previousMax + 1) > budgetMicroamps * 255);
+                TEST_ASSERT_TRUE(current * (max + 1) > budgetMicroamps * 255);
+                counts.drops++;
+            } else if (max > previousMax) {
+                // Up only as far as leaves the margin.
+                TEST_ASSERT_TRUE(current * max <= releaseBudget * 255);
+                counts.rises++;
+            }
+
+            seed = seed * 1103515245 + 12345;
+            now = due + (seed >> 8) % (2 * scrollDelay * 1000 + 1);
+        }
+    }
+
+    void testScrolling(bool smooth, uint8_t loopGap) {
+        Harness harness;
+        MarqueeController& marquee = harness.marquee;
+        marquee.setSmoothScrolling(smooth);
+        marquee.setLoopGap(loopGap);
+        marquee.setMessage(message);
+
+        uint32_t now = startTime;
+        Counts counts;
+
+        // White goes over the budget.
+        run(harness, now, partTime, smooth, counts);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, counts.drops);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, harness.metrics.powerLimitedFrames.get());
+
+        // Each change comes from the web server between frames, on its own,
+        // so none of them has the load recounted on the back of another.
+        TEST_ASSERT_TRUE(marquee.postBrightness(100));
+        run(harness, now, partTime, smooth, counts);
+
+        TEST_ASSERT_TRUE(marquee.postBrightness(255));
+        run(harness, now, partTime, smooth, counts);
+
+        TEST_ASSERT_TRUE(marquee.postWhiteBalance(Color::RGB(255, 120, 60)));
+        run(harness, now, partTime, smooth, counts);
+
+        TEST_ASSERT_TRUE(marquee.postColor(0x00FF00));
+        run(harness, now, partTime, smooth, counts);
+
+        // Black is the rainbow, a different color every column.
+        TEST_ASSERT_TRUE(marquee.postColor(0));
+        run(harness, now, partTime, smooth, counts);
+
+        TEST_ASSERT_TRUE(marquee.postWhiteBalance(Color::RGB(255, 255, 255)));
+        run(harness, now, partTime, smooth, counts);
+
+        // The cap came back up for the dimmer parts.
+        TEST_ASSERT_GREATER_THAN_UINT32(1, counts.rises);
+        TEST_ASSERT_GREATER_THAN_UINT32(0, harness.metrics.skippedFrames.get());
+        TEST_ASSERT_EQUAL_UINT32(0, harness.simulated.bus.getStats().protocolErrors);
+
+        printf("%u steps, the cap came down %u times and went up %u times\n", unsigned(counts.steps), unsigned(counts.drops), unsigned(counts.rises));
+    }
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_stepped_scrolling() {
+    testScrolling(false, 0);
+}
+
+void test_smooth_scrolling() {
+    testScrolling(true, 0);
+}
+
+void test_looping_stepped_scrolling() {
+    testScrolling(false, 4);
+}
+
+void test_looping_smooth_scrolling() {
+    testScrolling(true, 4);
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stepped_scrolling);
+    RUN_TEST(test_smooth_scrolling);
+    RUN_TEST(test_looping_stepped_scrolling);
+    RUN_TEST(test_looping_smooth_scrolling);
+    return UNITY_END();
+}
@@ -0,0 +1,345 @@
+// Drives RenderScheduler::step() and the MarqueeController behind it from a
+// fake clock, waking the scheduler late by varying amounts the way a busy
+// device would, and checks that the timing still comes out right: frames keep
+// their cadence, late ones are skipped and counted rather than drawn in a
+// burst, and the message is wherever the time puts it, so it spends as long on
+// the display as it would have if nothing had been late.
+//
+//     pio test -e native -f test_render_timing
+
+#include <Arduino.h>
+#include <unity.h>
+#include <vector>
+
+#include "../../src/MarqueeController.h"
+#include "../../src/RenderScheduler.h"
+#include "../../src/PanelChain.h"
+#include "../../src/Metrics.h"
+#include "../../src/MessageText.h"
+#include "../../src/Playlist.h"
+#include "../../src/sim/SimulatedPanel.h"
+
+namespace {
+    // Starts 2 s short of the microsecond clock wrapping, so every run goes over it.
+    const uint32_t startTime = 0xFFFFFFFF - 2000000;
+
+    // RenderScheduler counts a frame that starts more than this late (us) as a missed deadline.
+    const uint32_t deadlineSlack = 1000;
+
+    // The shortest RenderScheduler sleeps for (us).
+    const uint32_t tickMicros = portTICK_PERIOD_MS * 1000;
+
+    const uint8_t scrollDelay = 20;
+    const char* longMessage = "Late frames are skipped, not drawn in a burst";
+
+    struct Harness {
+        Harness() :
+            simulated(metrics),
+            panel(&simulated.panel),
+            panels(&panel, 1),
+            marquee(panels, metrics),
+            scheduler(marquee, metrics)
+        {
+            marquee.setScrollDelay(scrollDelay);
+            marquee.setColor(0xFFFFFF);
+        }
+
+        Metrics metrics;
+        SimulatedPanel simulated;
+        DisplayPanel* panel;
+        PanelChain panels;
+        MarqueeController marquee;
+        RenderScheduler scheduler;
+    };
+
+    // What the display showed from a time on, in us since the run started.
+    struct Shown {
+        uint32_t time;
+        uint8_t pwm[DisplayFlusher::frameSize];
+    };
+
+    struct Run {
+        std::vector<Shown> shown;
+        // Each deadline step() returned, and when it was actually called back.
+        std::vector<uint32_t> deadlines;
+        std::vector<uint32_t> wakeups;
+        // Wakeups later than deadlineSlack.
+        uint32_t lateWakeups = 0;
+        uint32_t elapsed = 0;
+    };
+
+    // Steps the scheduler for duration us, waking it up to maxLate us after
+    // each deadline. The lateness is the same every run, so runs can be compared.
+    void run(Harness& harness, uint32_t duration, uint32_t maxLate, Run& result) {
+        uint32_t seed = 1;
+        uint32_t now = startTime;
+
+        while (now - startTime < duration) {
+            const uint32_t due = harness.scheduler.step(now);
+
+            Shown shown;
+            shown.time = now - startTime;
+            harness.simulated.bus.readPWM(shown.pwm);
+            result.shown.push_back(shown);
+
+            uint32_t late = 0;
+
+            if (maxLate > 0) {
+                seed = seed * 1103515245 + 12345;
+                late = (seed >> 8) % (maxLate + 1);
+            }
+
+            result.deadlines.push_back(due - startTime);
+            result.elapsed = now - startTime;
+            now = due + late;
+            result.wakeups.push_back(now - startTime);
+
+            if (late > deadlineSlack && now - startTime < duration) {
+                result.lateWakeups++;
+            }
+        }
+    }
+
+    // What the reference run was showing at time.
+    const Shown& shownAt(const Run& reference, uint32_t time) {
+        size_t i = 0;
+
+        while (i + 1 < reference.shown.size() && reference.shown[i + 1].time <= time) {
+            i++;
+        }
+
+        return reference.shown[i];
+    }
+
+    // The frames due from the start of the run up to time, whether they were
+    // drawn, found to be unchanged, or skipped.
+    void assertEveryFrameAccountedFor(const Harness& harness, uint32_t interval, uint32_t time) {
+        const Metrics& metrics = harness.metrics;
+        TEST_ASSERT_EQUAL_UINT32(time / interval, metrics.frames.get() + metrics.idleFrames.get() + metrics.skippedFrames.get());
+    }
+
+    void testLateWakeups(bool smooth, uint32_t maxLate) {
+        const uint32_t duration = 12000000;
+        const uint32_t interval = (smooth ? MarqueeController::smoothFrameInterval : scrollDelay) * 1000;
+
+        Harness reference;
+        reference.marquee.setSmoothScrolling(smooth);
+        reference.marquee.setMessage(longMessage);
+        Run onTime;
+        run(reference, duration + maxLate, 0, onTime);
+
+        TEST_ASSERT_EQUAL_UINT32(0, reference.metrics.skippedFrames.get());
+        TEST_ASSERT_EQUAL_UINT32(0, reference.metrics.missedDeadlines.get());
+
+        Harness harness;
+        harness.marquee.setSmoothScrolling(smooth);
+        harness.marquee.setMessage(longMessage);
+        Run late;
+        run(harness, duration, maxLate, late);
+
+        TEST_ASSERT_GREATER_THAN(0, late.lateWakeups);
+        TEST_ASSERT_EQUAL_UINT32(late.lateWakeups, harness.metrics.missedDeadlines.get());
+
+        // Waking more than a frame late skips the frames in between, and only that does.
+        if (maxLate >= interval) {
+            TEST_ASSERT_GREATER_THAN(0, harness.metrics.skippedFrames.get());
+        } else {
+            TEST_ASSERT_EQUAL_UINT32(0, harness.metrics.skippedFrames.get());
+        }
+
+        assertEveryFrameAccountedFor(harness, interval, late.elapsed);
+
+        // However late it woke, the display shows what it showed on time.
+        for (const Shown& shown : late.shown) {
+            const Shown& expected = shownAt(onTime, shown.time);
+
+            if (memcmp(expected.pwm, shown.pwm, sizeof(shown.pwm)) != 0) {
+                char description[96];
+                snprintf(description, sizeof(description), "frame at %u us doesn't match the one due at %u us", unsigned(shown.time), unsigned(expected.time));
+                TEST_FAIL_MESSAGE(description);
+            }
+        }
+    }
+
+    enum class Item : uint8_t {
+        none,
+        red,
+        blue
+    };
+
+    // Which playlist item the display shows, by its color.
+    Item itemShown(const Harness& harness, const uint8_t* pwm) {
+        const Adafruit_IS31FL3741_QT_buffered& display = harness.simulated.display;
+
+        for (int16_t y = 0; y < display.height(); y++) {
+            for (int16_t x = 0; x < display.width(); x++) {
+                uint8_t r, g, b;
+                display.getPixelRGB(pwm, x, y, r, g, b);
+
+                if (r > b) {
+                    return Item::red;
+                }
+
+                if (b > r) {
+                    return Item::blue;
+                }
+            }
+        }
+
+        return Item::none;
+    }
+
+    // When each item came on the display, and which it was.
+    void itemChanges(const Harness& harness, const Run& run, std::vector<uint32_t>& times, std::vector<Item>& items) {
+        Item current = Item::none;
+
+        for (const Shown& shown : run.shown) {
+            const Item item = itemShown(harness, shown.pwm);
+
+            if (item != Item::none && item != current) {
+                times.push_back(shown.time);
+                items.push_back(item);
+                current = item;
+            }
+        }
+    }
+
+    void startPlaylist(MarqueeController& marquee) {
+        Playlist* playlist = Playlist::create();
+        const char* messages[] = {"Red", "Blue"};
+        const uint32_t colors[] = {0xFF0000, 0x0000FF};
+
+        for (uint8_t i = 0; i < 2; i++) {
+            Playlist::Item item;
+            item.message = MessageText::copy(messages[i], MarqueeController::maxMessageLength);
+            item.fontID = Font::ID::adafruit;
+            item.color = colors[i];
+            item.repeat = 1;
+            item.fontIndex = 0;
+            item.colorIndex = 0;
+
+            playlist->add(item);
+            item.message->release();
+        }
+
+        marquee.setPlaylist(playlist);
+        playlist->release();
+    }
+}
+
+void setUp() {
+}
+
+void tearDown() {
+}
+
+void test_stepped_scrolling_survives_late_wakeups() {
+    // Up to two and a half frames late.
+    testLateWakeups(false, 50000);
+}
+
+void test_smooth_scrolling_survives_late_wakeups() {
+    // Up to three and a half frames late.
+    testLateWakeups(true, 35000);
+}
+
+void test_slightly_late_wakeups_skip_nothing() {
+    // Up to half a frame late.
+    testLateWakeups(false, scrollDelay * 1000 / 2);
+}
+
+// Deadlines stay on the frame grid the run started on, so a late frame doesn't
+// push the ones after it later. The scheduler always sleeps at least a tick,
+// though, so a frame due sooner than that waits the tick out.
+void test_deadlines_keep_their_cadence() {
+    const uint32_t interval = scrollDelay * 1000;
+
+    Harness onTime;
+    onTime.marquee.setMessage(longMessage);
+    Run steady;
+    run(onTime, 5000000, 0, steady);
+
+    for (size_t i = 0; i < steady.deadlines.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32((i + 1) * interval, steady.deadlines[i]);
+    }
+
+    TEST_ASSERT_EQUAL_UINT32(0, onTime.metrics.missedDeadlines.get());
+    assertEveryFrameAccountedFor(onTime, interval, steady.elapsed);
+
+    Harness harness;
+    harness.marquee.setMessage(longMessage);
+    Run late;
+    run(harness, 5000000, 3 * interval, late);
+
+    uint32_t offGrid = 0;
+
+    for (size_t i = 0; i < late.deadlines.size(); i++) {
+        // The next frame due after the step, never one it should already have drawn, nor one further on.
+        const uint32_t stepTime = (i == 0) ? 0 : late.wakeups[i - 1];
+        const uint32_t nextFrame = (stepTime / interval + 1) * interval;
+        TEST_ASSERT_EQUAL_UINT32(max(nextFrame, stepTime + tickMicros), late.deadlines[i]);
+
+        if (late.deadlines[i] != nextFrame) {
+            offGrid++;
+        }
+    }
+
+    // Only the frames that were due within a tick of the step.
+    TEST_ASSERT_LESS_THAN_UINT32(late.deadlines.size() / 10, offGrid);
+}
+
+// Each playlist item stays on the display for as long as its pass takes,
+// however late the frames are drawn.
+void test_playlist_items_stay_on_screen_for_their_time() {
+    const uint32_t duration = 10000000;
+    const uint32_t maxLate = 45000;
+
+    Harness reference;
+    startPlaylist(reference.marquee);
+    Run onTime;
+    run(reference, duration, 0, onTime);
+
+    std::vector<uint32_t> expectedTimes;
+    std::vector<Item> expectedItems;
+    itemChanges(reference, onTime, expectedTimes, expectedItems);
+
+    // Enough times round to compare.
+    TEST_ASSERT_GREATER_THAN(6, expectedTimes.size());
+
+    // On time, each item gets the same time on the display every time round.
+    for (size_t i = 3; i < expectedTimes.size(); i++) {
+        TEST_ASSERT_EQUAL_UINT32(expectedTimes[i - 1] - expectedTimes[i - 3], expectedTimes[i] - expectedTimes[i - 2]);
+    }
+
+    Harness harness;
+    startPlaylist(harness.marquee);
+    Run late;
+    run(harness, duration, maxLate, late);
+
+    std::vector<uint32_t> times;
+    std::vector<Item> items;
+    itemChanges(harness, late, times, items);
+
+    TEST_ASSERT_GREATER_THAN(0, harness.metrics.skippedFrames.get());
+
+    // The same items come on, in the same order, each no later than the
+    // wakeup after it was due. So every item spends the same time on the
+    // display, give or take one wakeup's lateness.
+    TEST_ASSERT_EQUAL(expectedTimes.size(), times.size());
+
+    for (size_t i = 0; i < times.size(); i++) {
+        TEST_ASSERT_EQUAL(int(expectedItems[i]), int(items[i]));
+        TEST_ASSERT_GREATER_OR_EQUAL_UINT32(expectedTimes[i], times[i]);
+        TEST_ASSERT_LESS_OR_EQUAL_UINT32(expectedTimes[i] + maxLate, times[i]);
+    }
+}
+
+int main(int argc, char** argv) {
+    UNITY_BEGIN();
+    RUN_TEST(test_stepped_scrolling_survives_late_wakeups);
+    RUN_TEST(test_smooth_scrolling_survives_late_wakeups);
+    RUN_TEST(test_slightly_late_wakeups_skip_nothing);
+    RUN_TEST(test_deadlines_keep_their_cadence);
+    RUN_TEST(test_playlist_items_stay_on_screen_for_their_time);
+    return UNITY_END();
+}
@@ -0,0 +1,198 @@
+#!/usr/bin/env python3
+"""Generates src/fonts/ColumnFonts.h from the GFXfont headers in src/fonts.
+
+Each font's printable ASCII glyphs are converted from the Adafruit GFX
+row-major bitmaps into ColumnFont's layout (see src/ColumnFont.h): one
+byte per column of 8 pixels, bit 0 at the font's top row. The conversion
+follows the GFX library's drawChar(), so glyphs drawn from the columns land
+on exactly the same pixels.
+
+The classic built-in font lives inside the GFX library, so only its glyph
+and advance tables are generated here. Its columns are captured from GFX at
+runtime (see Font.cpp).
+
+Run it from the repository root after changing a font:
+
+    python3 tools/column_fonts.py
+"""
+
+import os
+import re
+import sys
+
+FONTS_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "fonts")
+OUTPUT = os.path.join(FONTS_DIR, "ColumnFonts.h")
+
+# (header, GFXfont name, name for the generated ColumnFont)
+FONTS = [
+    ("Font5x7Fixed.h", "Font5x7Fixed", "fixed"),
+    ("Font5x7FixedMono.h", "Font5x7FixedMono", "fixedMono"),
+    ("Ancient4x8.h", "Ancient4x8", "ancient"),
+]
+
+FIRST = 0x20
+COUNT = 95
+COLUMN_HEIGHT = 8
+
+CLASSIC_WIDTH = 5
+CLASSIC_ADVANCE = 6
+
+
+def strip_comments(source):
+    source = re.sub(r"/\*.*?\*/", "", source, flags=re.S)
+    return re.sub(r"//[^\n]*", "", source)
+
+
+def array_body(source, name):
+    match = re.search(r"\b" + re.escape(name) + r"\s*\[\s*\]\s*PROGMEM\s*=\s*\{(.*?)\};", source, re.S)
+
+    if match is None:
+        sys.exit("Couldn't find array %s" % name)
+
+    return match.group(1)
+
+
+def parse_numbers(text):
+    return [int(n, 0) for n in re.findall(r"-?(?:0x[0-9A-Fa-f]+|\d+)", text)]
+
+
+def parse_font(path, name):
+    source = strip_comments(open(path).read())
+
+    font = re.search(r"const\s+GFXfont\s+" + re.escape(name) + r"\s+PROGMEM\s*=\s*\{(.*?)\};", source, re.S)
+
+    if font is None:
+        sys.exit("Couldn't find GFXfont %s in %s" % (name, path))
+
+    parts = [p.strip() for p in font.group(1).split(",")]
+    bitmap_name = re.search(r"(\w+)\s*$", parts[0]).group(1)
+    glyph_name = re.search(r"(\w+)\s*$", parts[1]).group(1)
+    first, last = int(parts[2], 0), int(parts[3], 0)
+
+    bitmap = parse_numbers(array_body(source, bitmap_name))
+    glyphs = [parse_numbers(g) for g in re.findall(r"\{([^{}]*)\}", array_body(source, glyph_name))]
+
+    if len(glyphs) != last - first + 1:
+        sys.exit("%s: expected %d glyphs, found %d" % (name, last - first + 1, len(glyphs)))
+
+    if first > FIRST or last < FIRST + COUNT - 1:
+        sys.exit("%s doesn't cover printable ASCII" % name)
+
+    return first, bitmap, glyphs
+
+
+def glyph_pixels(bitmap, glyph):
+    """Pixels set by GFX drawChar(), relative to the cursor, in drawing order."""
+    offset, width, height, _, x_offset, y_offset = glyph
+    pixels = []
+    bit = 0
+    bits = 0
+
+    for yy in range(height):
+        for xx in range(width):
+            if bit & 7 == 0:
+                bits = bitmap[offset]
+                offset += 1
+
+            bit += 1
+
+            if bits & 0x80:
+                pixels.append((x_offset + xx, y_offset + yy))
+
+            bits = (bits << 1) & 0xFF
+
+    return pixels
+
+
+def convert(name, first, bitmap, glyphs):
+    chars = [glyphs[c - first] for c in range(FIRST, FIRST + COUNT)]
+    drawn = [glyph_pixels(bitmap, g) for g in chars]
+
+    # Top row of the column bytes: the highest pixel any glyph sets.
+    rows = [y for pixels in drawn for (_, y) in pixels]
+    top = min(rows)
+
+    if max(rows) - top >= COLUMN_HEIGHT:
+        sys.exit("%s is taller than %d pixels" % (name, COLUMN_HEIGHT))
+
+    columns = []
+    table = []
+
+    for glyph, pixels in zip(chars, drawn):
+        width = glyph[1] if glyph[2] > 0 else 0
+        glyph_columns = [0] * width
+
+        for (x, y) in pixels:
+            glyph_columns[x - glyph[4]] |= 1 << (y - top)
+
+        table.append((len(columns), glyph[4], width))
+        columns.extend(glyph_columns)
+
+    advances = [g[3] for g in chars]
+    return top, columns, table, advances
+
+
+def char_comment(c):
+    return "0x%02X %s" % (c, repr(chr(c)))
+
+
+def write_font(out, name, top, columns, table, advances, columns_name=None):
+    if columns is not None:
+        out.append("    const uint8_t %sColumns[] PROGMEM = {" % name)
+
+        for i in range(0, len(columns), 16):
+            out.append("        " + ", ".join("0x%02X" % b for b in columns[i:i + 16]) + ",")
+
+        out.append("    };")
+        out.append("")
+
+    out.append("    const ColumnFont::Glyph %sGlyphs[] PROGMEM = {" % name)
+
+    for i, (offset, x, width) in enumerate(table):
+        out.append("        {%4d, %2d, %d},  // %s" % (offset, x, width, char_comment(FIRST + i)))
+
+    out.append("    };")
+    out.append("")
+    out.append("    const uint8_t %sAdvances[] PROGMEM = {" % name)
+
+    for i in range(0, len(advances), 16):
+        out.append("        " + ", ".join("%d" % a for a in advances[i:i + 16]) + ",")
+
+    out.append("    };")
+    out.append("")
+    out.append("    const ColumnFont %s PROGMEM = {%s, %sGlyphs, %sAdvances, %d};" % (
+        name, columns_name or (name + "Columns"), name, name, top))
+    out.append("")
+
+
+def main():
+    out = [
+        "// Generated by tools/column_fonts.py from the GFXfont headers in this directory.",
+        "// Don't edit by hand; change the fonts and run the script again.",
+        "",
+        "#pragma once",
+        "",
+        "#include \"../ColumnFont.h\"",
+        "",
+        "namespace ColumnFonts {",
+        "    // The classic font's columns are filled in from the GFX library at runtime.",
+        "    extern uint8_t classicColumns[%d];" % (COUNT * CLASSIC_WIDTH),
+        "",
+    ]
+
+    classic_table = [(i * CLASSIC_WIDTH, 0, CLASSIC_WIDTH) for i in range(COUNT)]
+    write_font(out, "classic", 0, None, classic_table, [CLASSIC_ADVANCE] * COUNT, "classicColumns")
+
+    for header, gfx_name, name in FONTS:
+        first, bitmap, glyphs = parse_font(os.path.join(FONTS_DIR, header), gfx_name)
+        top, columns, table, advances = convert(gfx_name, first, bitmap, glyphs)
+        write_font(out, name, top, columns, table, advances)
+
+    out[-1:] = ["}"]
+
+    with open(OUTPUT, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()
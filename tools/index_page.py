@@ -0,0 +1,151 @@
+#!/usr/bin/env python3
+"""Generates src/html/index_page.h from the page template in src/html/index_html.h.
+
+The template is split into the segments WebRenderer streams the page from
+(see src/WebRenderer.h), so nothing is searched for or copied into RAM when
+the page is served:
+
+    {{field}}               filled in from the settings, e.g. {{backgroundColor}}
+    {{#section}}...{{/section}}
+                            repeated for each item of a setting, e.g. {{#colors}},
+                            with {{index}}, {{selected}}, {{name}} and {{color}}
+                            filling in that item
+
+Field and section names are WebRenderer::Field and WebRenderer::Section
+values, so a misspelled one fails to compile. A section tag alone on its line
+takes the line with it. Sections don't nest.
+
+Run it from the repository root after changing the page:
+
+    python3 tools/index_page.py
+"""
+
+import os
+import re
+import sys
+
+HTML_DIR = os.path.join(os.path.dirname(os.path.abspath(__file__)), "..", "src", "html")
+TEMPLATE = os.path.join(HTML_DIR, "index_html.h")
+OUTPUT = os.path.join(HTML_DIR, "index_page.h")
+
+TAG = re.compile(r"\{\{([#/]?)(\w+)\}\}")
+STANDALONE_SECTION_TAG = re.compile(r"^[ \t]*(\{\{[#/]\w+\}\})[ \t]*\n", re.M)
+
+MAX_LENGTH = 0xFFFF
+
+
+def read_template(path):
+    match = re.search(r'R"rawliteral\((.*)\)rawliteral"', open(path).read(), re.S)
+
+    if match is None:
+        sys.exit("Couldn't find the page's raw string in %s" % path)
+
+    return match.group(1)
+
+
+def split(page):
+    page = STANDALONE_SECTION_TAG.sub(r"\1", page)
+    segments = []
+    section = None
+    position = 0
+
+    for match in TAG.finditer(page):
+        if match.start() > position:
+            segments.append(("literal", page[position:match.start()]))
+
+        position = match.end()
+        kind, name = match.groups()
+
+        if kind == "#":
+            if section is not None:
+                sys.exit("Section %s starts inside section %s" % (name, section))
+
+            section = name
+            segments.append(("sectionStart", name))
+        elif kind == "/":
+            if section != name:
+                sys.exit("Section %s ends but %s is open" % (name, section))
+
+            section = None
+            segments.append(("sectionEnd", name))
+        else:
+            segments.append(("field", name))
+
+    if section is not None:
+        sys.exit("Section %s never ends" % section)
+
+    if position < len(page):
+        segments.append(("literal", page[position:]))
+
+    return segments
+
+
+def escape(text):
+    out = ""
+
+    for byte in text.encode("utf-8"):
+        c = chr(byte)
+
+        if c == "\\" or c == '"':
+            out += "\\" + c
+        elif c == "\n":
+            out += "\\n"
+        elif 0x20 <= byte < 0x7F:
+            out += c
+        else:
+            out += "\\%03o" % byte
+
+    return out
+
+
+def write_literal(out, text):
+    length = len(text.encode("utf-8"))
+
+    if length > MAX_LENGTH:
+        sys.exit("A run of text is %d bytes, over %d" % (length, MAX_LENGTH))
+
+    lines = text.splitlines(True)
+    out.append("        {WebRenderer::Segment::literal, 0, %d," % length)
+
+    for line in lines:
+        out.append("            \"%s\"" % escape(line))
+
+    out[-1] += "},"
+
+
+def main():
+    segments = split(read_template(TEMPLATE))
+
+    out = [
+        "// Generated by tools/index_page.py from the template in index_html.h.",
+        "// Don't edit by hand; change the template and run the script again.",
+        "",
+        "#pragma once",
+        "",
+        "#include \"../WebRenderer.h\"",
+        "",
+        "namespace IndexPage {",
+        "    const WebRenderer::Segment segments[] PROGMEM = {",
+    ]
+
+    for kind, value in segments:
+        if kind == "literal":
+            write_literal(out, value)
+        elif kind == "field":
+            out.append("        {WebRenderer::Segment::field, uint8_t(WebRenderer::Field::%s), 0, nullptr}," % value)
+        else:
+            out.append("        {WebRenderer::Segment::%s, uint8_t(WebRenderer::Section::%s), 0, nullptr}," % (kind, value))
+
+    out += [
+        "    };",
+        "",
+        "    const uint16_t segmentCount = sizeof(segments) / sizeof(segments[0]);",
+        "}",
+    ]
+
+    with open(OUTPUT, "w") as f:
+        f.write("\n".join(out) + "\n")
+
+
+if __name__ == "__main__":
+    main()